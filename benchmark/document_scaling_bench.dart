@@ -0,0 +1,326 @@
+// Document scaling benchmark: synthetic documents from 1k to 100k mixed
+// strokes. For each size it measures paint time at several zoom levels and
+// viewport positions, memory footprint, undo latency, endStroke latency,
+// object eraser hit-test latency and paint time with the document on a
+// cached layer.
+//
+//   flutter test --tags benchmark benchmark/document_scaling_bench.dart
+//
+// SCALING_BENCH_SIZES=1000,5000 overrides the stroke counts. Curves are
+// written as JSON to build/benchmark/document_scaling.json, or to the path
+// in SCALING_BENCH_OUT.
+@Tags(['benchmark'])
+library;
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:get/get.dart';
+import 'package:professional_sketcher/controllers/sketch_controller.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/eraser_mode.dart';
+import 'package:professional_sketcher/models/sketch_layer.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'package:professional_sketcher/utils/memory_manager.dart';
+import 'support/allocation_probe.dart';
+import 'support/synthetic_strokes.dart';
+
+const List<int> _defaultSizes = [
+  1000,
+  2000,
+  5000,
+  10000,
+  20000,
+  50000,
+  100000,
+];
+const Size _world = Size(16000, 16000);
+const Size _screen = Size(1280, 800);
+const List<double> _zooms = [0.1, 0.5, 1.0, 4.0];
+const int _paintRuns = 3;
+const int _undoRuns = 20;
+const double _frameBudgetMs = 1000 / 60;
+// Once a viewport variant takes this long, larger documents are skipped
+const double _giveUpMs = 5000;
+
+class _Viewport {
+  final String name;
+  final double zoom;
+  final Rect rect;
+
+  const _Viewport(this.name, this.zoom, this.rect);
+}
+
+List<_Viewport> _viewports() {
+  return [
+    for (final zoom in _zooms) ...[
+      _Viewport('zoom${zoom}_corner', zoom, Offset.zero & (_screen / zoom)),
+      _Viewport(
+          'zoom${zoom}_center',
+          zoom,
+          Rect.fromCenter(
+            center: _world.center(Offset.zero),
+            width: _screen.width / zoom,
+            height: _screen.height / zoom,
+          )),
+    ],
+  ];
+}
+
+List<int> _sizes() {
+  final env = Platform.environment['SCALING_BENCH_SIZES'];
+  if (env == null || env.trim().isEmpty) return _defaultSizes;
+  return env.split(',').map((s) => int.parse(s.trim())).toList();
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  test('document scaling: paint, memory, undo and endStroke by stroke count',
+      () async {
+    Get.testMode = true;
+    final sizes = _sizes();
+    final viewports = _viewports();
+    final probe = await AllocationProbe.connect();
+
+    final curves = <String, List<num?>>{
+      'firstFrameMs': [],
+      for (final v in viewports) ...{
+        'recordMs.${v.name}': <num?>[],
+        'rasterMs.${v.name}': <num?>[],
+      },
+      'accountedBytes': [],
+      'rssDeltaBytes': [],
+      if (probe != null) 'heapBytes': [],
+      'undoUs': [],
+      'endStrokeUs': [],
+      'strokesAfterEndStroke': [],
+      'objectEraseStartUs': [],
+      'objectEraseMoveUs': [],
+      'recordMs.layered': [],
+    };
+
+    for (final count in sizes) {
+      SketchPainter.clearStrokeCache();
+      SketchPainter.clearBoundsCache();
+
+      final rssBefore = ProcessInfo.currentRss;
+      final document = SyntheticDocument.generate(count, worldSize: _world);
+      curves['rssDeltaBytes']!.add(ProcessInfo.currentRss - rssBefore);
+      curves['accountedBytes']!.add(MemoryManager.accountedBytes(document));
+      if (probe != null) curves['heapBytes']!.add(await probe.heapUsage());
+
+      // Cold frame: whole document in view, nothing cached yet
+      final fit = _Viewport('fit', _screen.width / _world.width,
+          Offset.zero & _world);
+      final cold = Stopwatch()..start();
+      (await _rasterize(_record(document, fit))).dispose();
+      cold.stop();
+      curves['firstFrameMs']!.add(cold.elapsedMicroseconds / 1000.0);
+
+      for (final v in viewports) {
+        final record = curves['recordMs.${v.name}']!;
+        final raster = curves['rasterMs.${v.name}']!;
+        if (record.isNotEmpty &&
+            (record.last == null || record.last! + raster.last! > _giveUpMs)) {
+          record.add(null);
+          raster.add(null);
+          continue;
+        }
+        final (recordMs, rasterMs) = await _paintViewport(document, v);
+        record.add(recordMs);
+        raster.add(rasterMs);
+      }
+
+      curves['undoUs']!.add(_undoLatency(document));
+      final (endStrokeUs, strokesAfter) = _endStrokeLatency(document);
+      curves['endStrokeUs']!.add(endStrokeUs);
+      curves['strokesAfterEndStroke']!.add(strokesAfter);
+      final (startUs, moveUs) = _objectEraseLatency(document);
+      curves['objectEraseStartUs']!.add(startUs);
+      curves['objectEraseMoveUs']!.add(moveUs);
+      curves['recordMs.layered']!.add(_layeredRecordMs(document, fit));
+
+      debugPrint('document_scaling: $count strokes, '
+          'first frame ${curves['firstFrameMs']!.last} ms');
+    }
+    await probe?.dispose();
+    SketchPainter.clearStrokeCache();
+    SketchPainter.clearBoundsCache();
+    Get.reset();
+
+    // Smallest document whose paint no longer fits a 60 Hz frame
+    final fallsOver = <String, int?>{
+      for (final v in viewports)
+        v.name: _firstOver(sizes, curves['recordMs.${v.name}']!,
+            curves['rasterMs.${v.name}']!),
+    };
+
+    final report = <String, Object?>{
+      'benchmark': 'document_scaling',
+      'world': {'width': _world.width, 'height': _world.height},
+      'screen': {'width': _screen.width, 'height': _screen.height},
+      'frameBudgetMs': _frameBudgetMs,
+      'strokeCounts': sizes,
+      'curves': curves,
+      'fallsOverAt': fallsOver,
+      'notes': [
+        'recordMs/rasterMs are medians of $_paintRuns warm frames.',
+        'null means skipped after a smaller document exceeded '
+            '${_giveUpMs.toInt()} ms.',
+        'endStroke trims the document to MemoryManager\'s stroke cap, see '
+            'strokesAfterEndStroke.',
+        'objectEraseStartUs includes building the stroke index; '
+            'objectEraseMoveUs is the median hit test and delete per move.',
+        'recordMs.layered paints the fit view with the document on an '
+            'inactive layer under an empty active one.',
+      ],
+    };
+    final out = File(Platform.environment['SCALING_BENCH_OUT'] ??
+        'build/benchmark/document_scaling.json');
+    out.parent.createSync(recursive: true);
+    out.writeAsStringSync(const JsonEncoder.withIndent('  ').convert(report));
+    debugPrint('document_scaling: ${sizes.length} sizes -> ${out.path}');
+
+    expect(curves['firstFrameMs']!.length, sizes.length);
+  }, timeout: Timeout.none);
+}
+
+ui.Picture _record(List<Stroke> document, _Viewport viewport,
+    {List<SketchLayer> layers = const <SketchLayer>[], int activeLayer = 0}) {
+  final painter = SketchPainter(
+    strokes: document,
+    isImageVisible: false,
+    viewport: viewport.rect,
+    layers: layers,
+    activeLayer: activeLayer,
+  );
+  final recorder = ui.PictureRecorder();
+  final canvas = Canvas(recorder, Offset.zero & _screen);
+  canvas.scale(viewport.zoom);
+  canvas.translate(-viewport.rect.left, -viewport.rect.top);
+  painter.paint(canvas, _world);
+  return recorder.endRecording();
+}
+
+Future<ui.Image> _rasterize(ui.Picture picture) async {
+  try {
+    return await picture.toImage(
+        _screen.width.toInt(), _screen.height.toInt());
+  } finally {
+    picture.dispose();
+  }
+}
+
+Future<(double, double)> _paintViewport(
+    List<Stroke> document, _Viewport viewport) async {
+  // Warm-up frame fills bounds and paint caches for this view
+  (await _rasterize(_record(document, viewport))).dispose();
+
+  final recordUs = <int>[];
+  final rasterUs = <int>[];
+  for (int i = 0; i < _paintRuns; i++) {
+    final watch = Stopwatch()..start();
+    final picture = _record(document, viewport);
+    recordUs.add(watch.elapsedMicroseconds);
+    watch.reset();
+    final image = await _rasterize(picture);
+    rasterUs.add(watch.elapsedMicroseconds);
+    image.dispose();
+  }
+  return (_median(recordUs) / 1000.0, _median(rasterUs) / 1000.0);
+}
+
+double _layeredRecordMs(List<Stroke> document, _Viewport viewport) {
+  final layers = [
+    SketchLayer(id: 0, name: 'Document', strokes: document.obs),
+    SketchLayer(id: 1, name: 'Active'),
+  ];
+  // Warm-up frame records the document layer's picture
+  _record(layers[1].strokes, viewport, layers: layers, activeLayer: 1)
+      .dispose();
+  final samples = <int>[];
+  for (int i = 0; i < _paintRuns; i++) {
+    final watch = Stopwatch()..start();
+    _record(layers[1].strokes, viewport, layers: layers, activeLayer: 1)
+        .dispose();
+    samples.add(watch.elapsedMicroseconds);
+  }
+  SketchPainter.clearLayerPictures();
+  return _median(samples) / 1000.0;
+}
+
+double _undoLatency(List<Stroke> document) {
+  final controller = SketchController();
+  // The strokes undone are drawn for real, so each undo reverts an edit
+  final drawn = document.length < _undoRuns ? document.length : _undoRuns;
+  controller.strokes.assignAll(document.take(document.length - drawn));
+  for (final stroke in document.skip(document.length - drawn)) {
+    final points = stroke.points;
+    controller.startStroke(points.first.offset, points.first.pressure);
+    for (final point in points.skip(1)) {
+      controller.addPoint(point.offset, point.pressure);
+    }
+    controller.endStroke();
+  }
+  final samples = <int>[];
+  for (int i = 0; i < drawn; i++) {
+    final watch = Stopwatch()..start();
+    controller.undo();
+    samples.add(watch.elapsedMicroseconds);
+  }
+  controller.onDelete();
+  return _median(samples);
+}
+
+(double, int) _endStrokeLatency(List<Stroke> document) {
+  final controller = SketchController();
+  controller.strokes.assignAll(document);
+  controller.startStroke(const Offset(100, 100), 1.0);
+  for (int i = 1; i <= 30; i++) {
+    controller.addPoint(Offset(100.0 + i * 4, 100.0 + i * 2), 1.0);
+  }
+  final watch = Stopwatch()..start();
+  controller.endStroke();
+  watch.stop();
+  final strokes = controller.strokes.length;
+  controller.onDelete();
+  return (watch.elapsedMicroseconds.toDouble(), strokes);
+}
+
+(double, double) _objectEraseLatency(List<Stroke> document) {
+  final controller = SketchController();
+  controller.strokes.assignAll(document);
+  controller.setTool(DrawingTool.eraser);
+  controller.setEraserMode(EraserMode.object);
+  final watch = Stopwatch()..start();
+  controller.startStroke(const Offset(100, 100), 1.0);
+  final startUs = watch.elapsedMicroseconds.toDouble();
+  final samples = <int>[];
+  for (int i = 1; i <= 60; i++) {
+    watch.reset();
+    controller.addPoint(Offset(100.0 + i * 8, 100.0 + i * 4), 1.0);
+    samples.add(watch.elapsedMicroseconds);
+  }
+  controller.endStroke();
+  controller.onDelete();
+  return (startUs, _median(samples));
+}
+
+double _median(List<int> samples) {
+  if (samples.isEmpty) return 0.0;
+  final sorted = [...samples]..sort();
+  return sorted[sorted.length ~/ 2].toDouble();
+}
+
+int? _firstOver(List<int> sizes, List<num?> record, List<num?> raster) {
+  for (int i = 0; i < sizes.length; i++) {
+    final r = record[i];
+    final s = raster[i];
+    if (r == null || s == null || r + s > _frameBudgetMs) return sizes[i];
+  }
+  return null;
+}
@@ -0,0 +1,282 @@
+// Pen-to-pixel latency benchmark: synthetic pointer events with known
+// timestamps go through GestureBinding into the real DrawingCanvas. After
+// every frame the canvas is read back, and each event is matched to the
+// first frame whose pixels show the live stroke at its position.
+//
+//   flutter test --tags benchmark benchmark/latency_bench.dart
+//
+// Latency is the event's timestamp to the end of that frame: the wait for
+// the frame's vsync, plus the measured build and raster time of the frame.
+// Frames run on the test binding's fake clock at 60 Hz, so the wait is
+// exact and only the frame work is wall-clock. Each case is one input
+// scheduling strategy at one input rate. Results are written as JSON to
+// build/benchmark/latency_bench.json, or to the path in LATENCY_BENCH_OUT.
+@Tags(['benchmark'])
+library;
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+import 'package:flutter/gestures.dart';
+import 'package:flutter/material.dart';
+import 'package:flutter/rendering.dart';
+import 'package:flutter/scheduler.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:get/get.dart';
+import 'package:professional_sketcher/controllers/sketch_controller.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'package:professional_sketcher/widgets/drawing_canvas.dart';
+
+const Size _screen = Size(1280, 800);
+const Duration _vsync = Duration(microseconds: 16667);
+const List<int> _inputRatesHz = [60, 120, 240];
+const int _moves = 120;
+const double _step = 4.0;
+// Frames to wait for the last events before counting them as never shown
+const int _drainFrames = 8;
+// A pixel counts as ink once any channel moves this far from the baseline
+const int _inkThreshold = 48;
+
+/// One way of getting pointer events to the canvas.
+class _Strategy {
+  final String name;
+  final bool resampling;
+  final Duration samplingOffset;
+
+  const _Strategy(this.name, {this.resampling = false})
+      : samplingOffset = const Duration(milliseconds: -38);
+
+  const _Strategy.resampled(this.name, this.samplingOffset)
+      : resampling = true;
+}
+
+const List<_Strategy> _strategies = [
+  _Strategy('immediate'),
+  _Strategy.resampled('resampled', Duration(milliseconds: -38)),
+  _Strategy.resampled('resampledOneFrame', Duration(milliseconds: -17)),
+];
+
+void main() {
+  final binding = TestWidgetsFlutterBinding.ensureInitialized();
+
+  testWidgets('pen-to-pixel latency by input strategy and rate',
+      (tester) async {
+    tester.view.physicalSize = _screen;
+    tester.view.devicePixelRatio = 1.0;
+    addTearDown(tester.view.reset);
+
+    final results = <Map<String, Object?>>[];
+    for (final strategy in _strategies) {
+      for (final rate in _inputRatesHz) {
+        results.add(await _benchCase(tester, binding, strategy, rate));
+      }
+    }
+    GestureBinding.instance.resamplingEnabled = false;
+
+    final report = <String, Object?>{
+      'benchmark': 'latency',
+      'screen': {'width': _screen.width, 'height': _screen.height},
+      'vsyncMs': _vsync.inMicroseconds / 1000.0,
+      'movesPerCase': _moves,
+      'results': results,
+      'notes': [
+        'latencyMs runs from the event timestamp to the end of the first '
+            'frame whose readback shows ink at the event position.',
+        'Frame work is pump() plus toImage() wall time; toImage includes '
+            'the readback, so rasterMs is an upper bound.',
+        'missed counts events still not visible $_drainFrames frames after '
+            'the last one.',
+      ],
+    };
+    final out = File(Platform.environment['LATENCY_BENCH_OUT'] ??
+        'build/benchmark/latency_bench.json');
+    out.parent.createSync(recursive: true);
+    out.writeAsStringSync(const JsonEncoder.withIndent('  ').convert(report));
+    debugPrint('latency_bench: ${results.length} cases -> ${out.path}');
+
+    expect(results.length, _strategies.length * _inputRatesHz.length);
+  }, timeout: Timeout.none);
+}
+
+Future<Map<String, Object?>> _benchCase(
+  WidgetTester tester,
+  TestWidgetsFlutterBinding binding,
+  _Strategy strategy,
+  int rateHz,
+) async {
+  Get.reset();
+  Get.testMode = true;
+  SketchPainter.clearStrokeCache();
+  final controller = Get.put(SketchController());
+  controller.setTool(DrawingTool.pen);
+  controller.setBrushSize(6.0);
+
+  GestureBinding.instance.resamplingEnabled = strategy.resampling;
+  GestureBinding.instance.samplingOffset = strategy.samplingOffset;
+
+  await tester.pumpWidget(const MaterialApp(
+    home: Scaffold(body: DrawingCanvas()),
+  ));
+  await tester.pumpAndSettle();
+
+  final boundary = tester.renderObject<RenderRepaintBoundary>(find
+      .ancestor(
+        of: find.byWidgetPredicate(
+            (w) => w is CustomPaint && w.painter is SketchPainter),
+        matching: find.byType(RepaintBoundary),
+      )
+      .first);
+  final width = boundary.size.width.toInt();
+  final area = tester.getRect(find.byKey(const Key('drawing-area')));
+  final origin = Offset(area.left + 40, area.center.dy);
+  final baseline = await _readback(tester, boundary);
+
+  // Event timestamps share the frame timebase, which the resampler
+  // compares them against. Events start a third of a frame after a vsync.
+  controller.update();
+  await tester.pump();
+  final start = SchedulerBinding.instance.currentSystemFrameTimeStamp;
+  final interval = Duration(microseconds: 1000000 ~/ rateHz);
+  Duration timeAt(int i) => start + _vsync ~/ 3 + interval * i;
+
+  final positions = <Offset>[
+    for (int i = 0; i <= _moves; i++) origin + Offset(i * _step, 0),
+  ];
+  final shownAt = List<double?>.filled(positions.length, null);
+  final buildMs = <double>[];
+  final rasterMs = <double>[];
+  var clock = start;
+  var nextVsync = start + _vsync;
+
+  Future<void> advanceTo(Duration t) async {
+    if (t > clock) {
+      await binding.delayed(t - clock);
+      clock = t;
+    }
+  }
+
+  Future<void> frame(int sent) async {
+    await advanceTo(nextVsync);
+    nextVsync += _vsync;
+    final build = Stopwatch()..start();
+    await tester.pump();
+    build.stop();
+    final raster = Stopwatch()..start();
+    final pixels = await _readback(tester, boundary);
+    raster.stop();
+    final workMs = (build.elapsedMicroseconds + raster.elapsedMicroseconds) /
+        1000.0;
+    buildMs.add(build.elapsedMicroseconds / 1000.0);
+    rasterMs.add(raster.elapsedMicroseconds / 1000.0);
+
+    // The first move only starts the stroke once it clears the touch slop,
+    // so the down position is not an event of its own here
+    final frameTime = clock;
+    for (int i = 1; i < sent; i++) {
+      if (shownAt[i] != null) continue;
+      final local = boundary.globalToLocal(positions[i]);
+      if (_hasInk(pixels, baseline, width, local)) {
+        shownAt[i] =
+            (frameTime - timeAt(i)).inMicroseconds / 1000.0 + workMs;
+      }
+    }
+  }
+
+  await advanceTo(timeAt(0));
+  await tester.sendEventToBinding(PointerDownEvent(
+    timeStamp: timeAt(0),
+    pointer: 1,
+    kind: ui.PointerDeviceKind.stylus,
+    position: positions[0],
+  ));
+  for (int i = 1; i < positions.length; i++) {
+    while (timeAt(i) > nextVsync) {
+      await frame(i);
+    }
+    await advanceTo(timeAt(i));
+    await tester.sendEventToBinding(PointerMoveEvent(
+      timeStamp: timeAt(i),
+      pointer: 1,
+      kind: ui.PointerDeviceKind.stylus,
+      position: positions[i],
+      delta: const Offset(_step, 0),
+    ));
+  }
+  for (int i = 0;
+      i < _drainFrames && shownAt.skip(1).any((t) => t == null);
+      i++) {
+    await frame(positions.length);
+  }
+  await tester.sendEventToBinding(PointerUpEvent(
+    timeStamp: clock,
+    pointer: 1,
+    kind: ui.PointerDeviceKind.stylus,
+    position: positions.last,
+  ));
+  await tester.pumpAndSettle();
+
+  final latencies = shownAt.skip(1).whereType<double>().toList()..sort();
+  final framesRun = buildMs.length;
+  return <String, Object?>{
+    'strategy': strategy.name,
+    'resampling': strategy.resampling,
+    if (strategy.resampling)
+      'samplingOffsetMs': strategy.samplingOffset.inMicroseconds / 1000.0,
+    'inputRateHz': rateHz,
+    'events': positions.length - 1,
+    'missed': positions.length - 1 - latencies.length,
+    'frames': framesRun,
+    'latencyMs': {
+      'p50': _percentile(latencies, 50),
+      'p90': _percentile(latencies, 90),
+      'p99': _percentile(latencies, 99),
+      'max': _percentile(latencies, 100),
+    },
+    'buildMs': {'p50': _percentile(buildMs..sort(), 50)},
+    'rasterMs': {'p50': _percentile(rasterMs..sort(), 50)},
+  };
+}
+
+/// Straight RGBA copy of what the canvas boundary last composited.
+Future<Uint8List> _readback(
+    WidgetTester tester, RenderRepaintBoundary boundary) async {
+  final bytes = await tester.runAsync(() async {
+    final image = await boundary.toImage();
+    try {
+      final data = await image.toByteData(format: ui.ImageByteFormat.rawRgba);
+      return data!.buffer.asUint8List();
+    } finally {
+      image.dispose();
+    }
+  });
+  return bytes!;
+}
+
+/// Whether any pixel within one of [local] differs from the baseline.
+bool _hasInk(Uint8List pixels, Uint8List baseline, int width, Offset local) {
+  final height = pixels.length ~/ 4 ~/ width;
+  final cx = local.dx.round();
+  final cy = local.dy.round();
+  for (int y = cy - 1; y <= cy + 1; y++) {
+    if (y < 0 || y >= height) continue;
+    for (int x = cx - 1; x <= cx + 1; x++) {
+      if (x < 0 || x >= width) continue;
+      final i = (y * width + x) * 4;
+      for (int c = 0; c < 4; c++) {
+        if ((pixels[i + c] - baseline[i + c]).abs() >= _inkThreshold) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/// Nearest-rank percentile of [sorted]; [p] is in `0..100`.
+double? _percentile(List<double> sorted, double p) {
+  if (sorted.isEmpty) return null;
+  final rank = ((p / 100.0) * sorted.length).ceil();
+  return sorted[(rank - 1).clamp(0, sorted.length - 1)];
+}
@@ -0,0 +1,132 @@
+// Painter micro-benchmark: every tool and brush mode at several point counts
+// and widths, recorded through SketchPainter.paint and rasterized with
+// Picture.toImage.
+//
+//   flutter test --tags benchmark benchmark/painter_bench.dart
+//
+// Add --enable-vmservice to also report heap allocations. Results are
+// written as JSON to build/benchmark/painter_bench.json, or to the path in
+// PAINTER_BENCH_OUT.
+@Tags(['benchmark'])
+library;
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'support/allocation_probe.dart';
+import 'support/synthetic_strokes.dart';
+
+const List<int> _pointCounts = [10, 50, 200];
+const List<double> _widths = [5.0, 20.0, 50.0];
+const int _strokesPerFrame = 10;
+const int _iterations = 8;
+const Size _canvasSize = Size(1024, 768);
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  test('painter per-stroke cost by tool, brush mode, points and width',
+      () async {
+    final probe = await AllocationProbe.connect();
+    final results = <Map<String, Object?>>[];
+
+    for (final tool in BenchTool.all) {
+      for (final pointCount in _pointCounts) {
+        for (final width in _widths) {
+          results.add(await _benchCase(tool, pointCount, width, probe));
+        }
+      }
+    }
+    await probe?.dispose();
+
+    final report = <String, Object?>{
+      'benchmark': 'painter',
+      'canvas': {'width': _canvasSize.width, 'height': _canvasSize.height},
+      'strokesPerFrame': _strokesPerFrame,
+      'iterations': _iterations,
+      'allocationsMeasured': probe != null,
+      'results': results,
+    };
+    final out = File(Platform.environment['PAINTER_BENCH_OUT'] ??
+        'build/benchmark/painter_bench.json');
+    out.parent.createSync(recursive: true);
+    out.writeAsStringSync(const JsonEncoder.withIndent('  ').convert(report));
+    debugPrint('painter_bench: ${results.length} cases -> ${out.path}');
+
+    expect(results.length,
+        BenchTool.all.length * _pointCounts.length * _widths.length);
+  }, timeout: Timeout.none);
+}
+
+Future<Map<String, Object?>> _benchCase(
+  BenchTool tool,
+  int pointCount,
+  double width,
+  AllocationProbe? probe,
+) async {
+  final strokes = SyntheticStrokes.rows(
+    tool,
+    count: _strokesPerFrame,
+    pointCount: pointCount,
+    width: width,
+    size: _canvasSize,
+  );
+  SketchPainter.clearStrokeCache();
+  final painter = SketchPainter(strokes: strokes, isImageVisible: false);
+
+  // Warm-up frame fills the painter caches, as on a steady-state redraw
+  (await _rasterize(_record(painter))).dispose();
+
+  final record = Stopwatch();
+  final raster = Stopwatch();
+  int pictureBytes = 0;
+
+  await probe?.start();
+  for (int i = 0; i < _iterations; i++) {
+    record.start();
+    final picture = _record(painter);
+    record.stop();
+    pictureBytes = picture.approximateBytesUsed;
+
+    raster.start();
+    final image = await _rasterize(picture);
+    raster.stop();
+    image.dispose();
+  }
+  final allocations = await probe?.stop();
+
+  const samples = _iterations * _strokesPerFrame;
+  final recordUs = record.elapsedMicroseconds / samples;
+  final rasterUs = raster.elapsedMicroseconds / samples;
+  return <String, Object?>{
+    'tool': tool.name,
+    'points': pointCount,
+    'width': width,
+    'recordUsPerStroke': recordUs,
+    'rasterUsPerStroke': rasterUs,
+    'totalUsPerStroke': recordUs + rasterUs,
+    'pictureBytesPerStroke': pictureBytes / _strokesPerFrame,
+    if (allocations != null) ...{
+      'allocBytesPerStroke': allocations.bytes / samples,
+      'allocInstancesPerStroke': allocations.instances / samples,
+    },
+  };
+}
+
+ui.Picture _record(SketchPainter painter) {
+  final recorder = ui.PictureRecorder();
+  painter.paint(Canvas(recorder), _canvasSize);
+  return recorder.endRecording();
+}
+
+Future<ui.Image> _rasterize(ui.Picture picture) async {
+  try {
+    return await picture.toImage(
+        _canvasSize.width.toInt(), _canvasSize.height.toInt());
+  } finally {
+    picture.dispose();
+  }
+}
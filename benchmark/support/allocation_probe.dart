@@ -0,0 +1,66 @@
+import 'dart:developer' as developer;
+import 'dart:isolate';
+import 'package:vm_service/vm_service.dart';
+import 'package:vm_service/vm_service_io.dart';
+
+/// Heap allocation totals between [AllocationProbe.start] and
+/// [AllocationProbe.stop].
+class AllocationSample {
+  final int bytes;
+  final int instances;
+
+  const AllocationSample({required this.bytes, required this.instances});
+
+  Map<String, Object?> toJson() => {'bytes': bytes, 'instances': instances};
+}
+
+/// Counts Dart heap allocations of the current isolate via the VM service.
+///
+/// `flutter test` starts the tester without a VM service unless asked to
+/// (`--enable-vmservice`); in that case [connect] returns null and callers
+/// report timings only. Totals cover the whole isolate, so keep the measured
+/// region free of unrelated work.
+class AllocationProbe {
+  final VmService _service;
+  final String _isolateId;
+
+  AllocationProbe._(this._service, this._isolateId);
+
+  static Future<AllocationProbe?> connect() async {
+    try {
+      final info = await developer.Service.getInfo();
+      final uri = info.serverWebSocketUri;
+      final isolateId = developer.Service.getIsolateId(Isolate.current);
+      if (uri == null || isolateId == null) return null;
+      final service = await vmServiceConnectUri(uri.toString());
+      return AllocationProbe._(service, isolateId);
+    } catch (_) {
+      return null;
+    }
+  }
+
+  /// Resets the VM's accumulated allocation counters.
+  Future<void> start() async {
+    await _service.getAllocationProfile(_isolateId, reset: true);
+  }
+
+  /// Allocations since the last [start].
+  Future<AllocationSample> stop() async {
+    final profile = await _service.getAllocationProfile(_isolateId);
+    int bytes = 0;
+    int instances = 0;
+    for (final stats in profile.members ?? const <ClassHeapStats>[]) {
+      bytes += stats.accumulatedSize ?? 0;
+      instances += stats.instancesAccumulated ?? 0;
+    }
+    return AllocationSample(bytes: bytes, instances: instances);
+  }
+
+  /// Live Dart heap size of the isolate, in bytes.
+  Future<int> heapUsage() async {
+    final usage = await _service.getMemoryUsage(_isolateId);
+    return usage.heapUsage ?? 0;
+  }
+
+  Future<void> dispose() => _service.dispose();
+}
@@ -0,0 +1,163 @@
+import 'dart:math' as math;
+import 'package:flutter/material.dart';
+import 'package:professional_sketcher/models/brush_mode.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+
+/// One tool / brush mode combination to benchmark.
+class BenchTool {
+  final DrawingTool tool;
+  final BrushMode? brushMode;
+
+  const BenchTool(this.tool, [this.brushMode]);
+
+  String get name =>
+      brushMode == null ? tool.name : '${tool.name}.${brushMode!.name}';
+
+  /// Every tool, plus the basic brush and each brush mode.
+  static List<BenchTool> get all => [
+        for (final tool in DrawingTool.values)
+          if (tool != DrawingTool.brush) BenchTool(tool),
+        const BenchTool(DrawingTool.brush),
+        for (final mode in BrushMode.values) BenchTool(DrawingTool.brush, mode),
+      ];
+}
+
+/// Deterministic strokes shaped like real input.
+///
+/// Points follow a gentle wave with varying spacing and pressure, using the
+/// same per-tool opacity and blend mode as `SketchController.endStroke`, so
+/// every run of a benchmark paints exactly the same scene.
+class SyntheticStrokes {
+  SyntheticStrokes._();
+
+  static List<DrawingPoint> points(
+    int count, {
+    Offset origin = Offset.zero,
+    double spacing = 4.0,
+    int variant = 0,
+  }) {
+    final phase = variant * 0.7;
+    return List<DrawingPoint>.generate(count, (i) {
+      final t = i.toDouble();
+      final x = origin.dx + t * spacing * (1.0 + 0.25 * math.sin(t * 0.05));
+      final y = origin.dy + math.sin(t * 0.08 + phase) * spacing * 6.0;
+      final pressure = 0.55 + 0.45 * math.sin(t * 0.11 + phase).abs();
+      return DrawingPoint(
+        offset: Offset(x, y),
+        pressure: pressure,
+        timestamp: t * 8.0 + variant * 1000.0,
+      );
+    });
+  }
+
+  static Stroke stroke(
+    BenchTool benchTool, {
+    required int pointCount,
+    required double width,
+    Offset origin = Offset.zero,
+    int variant = 0,
+    Color color = Colors.black,
+  }) {
+    final tool = benchTool.tool;
+    final config = ToolConfig.configs[tool]!;
+    final isEraser = tool == DrawingTool.eraser;
+    return Stroke(
+      points: points(pointCount, origin: origin, variant: variant),
+      color: isEraser ? Colors.transparent : color,
+      width: width,
+      tool: tool,
+      opacity: config.opacity,
+      blendMode: config.blendMode,
+      isEraser: isEraser,
+      brushMode: benchTool.brushMode,
+    );
+  }
+
+  /// [count] strokes of one kind, stacked down a [size] canvas.
+  static List<Stroke> rows(
+    BenchTool benchTool, {
+    required int count,
+    required int pointCount,
+    required double width,
+    Size size = const Size(1024, 768),
+  }) {
+    final rowHeight = size.height / (count + 1);
+    return List<Stroke>.generate(
+      count,
+      (i) => stroke(
+        benchTool,
+        pointCount: pointCount,
+        width: width,
+        origin: Offset(8, rowHeight * (i + 1)),
+        variant: i,
+      ),
+    );
+  }
+}
+
+/// Large mixed documents for the scaling benchmarks.
+///
+/// Roughly what a long session leaves behind: mostly pen and pencil, some
+/// marker and textured brushes, and eraser strokes on top, scattered over
+/// a [worldSize] canvas. The [seed] fixes the layout.
+class SyntheticDocument {
+  SyntheticDocument._();
+
+  static const List<(BenchTool, int)> _mix = [
+    (BenchTool(DrawingTool.pen), 35),
+    (BenchTool(DrawingTool.pencil), 20),
+    (BenchTool(DrawingTool.marker), 10),
+    (BenchTool(DrawingTool.eraser), 10),
+    (BenchTool(DrawingTool.brush), 5),
+    (BenchTool(DrawingTool.brush, BrushMode.charcoal), 4),
+    (BenchTool(DrawingTool.brush, BrushMode.watercolor), 4),
+    (BenchTool(DrawingTool.brush, BrushMode.oilPaint), 3),
+    (BenchTool(DrawingTool.brush, BrushMode.airbrush), 3),
+    (BenchTool(DrawingTool.brush, BrushMode.calligraphy), 3),
+    (BenchTool(DrawingTool.brush, BrushMode.pastel), 3),
+  ];
+
+  static const List<Color> _palette = [
+    Colors.black,
+    Colors.blueGrey,
+    Colors.indigo,
+    Colors.redAccent,
+    Colors.teal,
+    Colors.orange,
+  ];
+
+  static List<Stroke> generate(
+    int count, {
+    Size worldSize = const Size(16000, 16000),
+    int seed = 42,
+  }) {
+    final random = math.Random(seed);
+    final totalWeight = _mix.fold<int>(0, (sum, e) => sum + e.$2);
+    return List<Stroke>.generate(count, (i) {
+      var pick = random.nextInt(totalWeight);
+      var tool = _mix.first.$1;
+      for (final (candidate, weight) in _mix) {
+        if (pick < weight) {
+          tool = candidate;
+          break;
+        }
+        pick -= weight;
+      }
+      final config = ToolConfig.configs[tool.tool]!;
+      final width = config.minWidth +
+          random.nextDouble() * (config.maxWidth - config.minWidth);
+      return SyntheticStrokes.stroke(
+        tool,
+        pointCount: 8 + random.nextInt(33),
+        width: width,
+        origin: Offset(
+          random.nextDouble() * (worldSize.width - 200),
+          200 + random.nextDouble() * (worldSize.height - 400),
+        ),
+        variant: i,
+        color: _palette[random.nextInt(_palette.length)],
+      );
+    });
+  }
+}
@@ -3,23 +3,205 @@ import 'package:get/get.dart';
 import '../models/stroke.dart';
 import '../models/drawing_tool.dart';
 import '../models/brush_mode.dart';
+import '../models/eraser_mode.dart';
+import '../models/sketch_document.dart';
+import '../models/sketch_layer.dart';
 import '../painters/sketch_painter.dart';
+import '../utils/lasso.dart';
 import '../utils/memory_manager.dart'; // Phase 4: Memory Management
+import '../utils/perf_trace.dart';
+import '../utils/runner_metrics.dart';
+import '../utils/sketch_log.dart';
+import '../utils/stall_watchdog.dart';
+import '../utils/stroke_index.dart';
+import '../utils/vector_eraser.dart';
+
+/// One step on the undo stack. Steps find their layer by id, so they stay
+/// valid while other layers come and go.
+abstract class _Edit {
+  const _Edit();
+
+  /// Whether the canvas still shows what this step left behind. A step
+  /// that does not is dropped instead of undone.
+  bool isCurrent(SketchController controller);
+
+  void revert(SketchController controller);
+}
+
+/// A stroke drawn onto a layer.
+class _AppendEdit extends _Edit {
+  final int layerId;
+  final Stroke stroke;
+
+  const _AppendEdit(this.layerId, this.stroke);
+
+  @override
+  bool isCurrent(SketchController controller) {
+    final strokes = controller._layerById(layerId)?.strokes;
+    return strokes != null &&
+        strokes.isNotEmpty &&
+        identical(strokes.last, stroke);
+  }
+
+  @override
+  void revert(SketchController controller) {
+    controller._layerById(layerId)!.strokes.removeLast();
+    SketchPainter.cleanupStrokeCaches(stroke);
+    controller._touchLayer(layerId);
+  }
+}
+
+/// A commit that replaced strokes instead of appending one, kept so [undo]
+/// can put the replaced strokes back.
+class _StrokeEdit extends _Edit {
+  final int layerId;
+  final List<Stroke> before;
+  final List<Stroke> after;
+
+  const _StrokeEdit(this.layerId, this.before, this.after);
+
+  @override
+  bool isCurrent(SketchController controller) {
+    final strokes = controller._layerById(layerId)?.strokes;
+    return strokes != null && SketchController._sameStrokes(strokes, after);
+  }
+
+  @override
+  void revert(SketchController controller) {
+    final kept = Set<Stroke>.identity()..addAll(before);
+    for (final stroke in after) {
+      if (!kept.contains(stroke)) SketchPainter.cleanupStrokeCaches(stroke);
+    }
+    controller._layerById(layerId)!.strokes.assignAll(before);
+    controller._touchLayer(layerId);
+  }
+}
+
+/// A layer added above [previousId], the layer that was active then.
+class _LayerAddEdit extends _Edit {
+  final int layerId;
+  final int previousId;
+
+  const _LayerAddEdit(this.layerId, this.previousId);
+
+  @override
+  bool isCurrent(SketchController controller) =>
+      controller._layerIndex(layerId) >= 0;
+
+  @override
+  void revert(SketchController controller) {
+    controller._removeLayerAt(controller._layerIndex(layerId));
+    final previous = controller._layerIndex(previousId);
+    if (previous >= 0) controller.setActiveLayer(previous);
+  }
+}
+
+/// A layer removed from [index], strokes and settings included.
+class _LayerRemoveEdit extends _Edit {
+  final SketchLayer layer;
+  final int index;
+  final bool wasActive;
+
+  const _LayerRemoveEdit(this.layer, this.index, this.wasActive);
+
+  @override
+  bool isCurrent(SketchController controller) =>
+      controller._layerIndex(layer.id) < 0;
+
+  @override
+  void revert(SketchController controller) {
+    final layers = controller.layers;
+    final at = index.clamp(0, layers.length);
+    final active = controller.activeLayerIndex.value;
+    layers.insert(at, layer.touched());
+    if (at <= active) controller.activeLayerIndex.value = active + 1;
+    if (wasActive) controller.setActiveLayer(at);
+  }
+}
+
+/// A change to a layer's opacity, visibility or blend mode; [before] holds
+/// the settings to go back to.
+class _LayerSettingsEdit extends _Edit {
+  final SketchLayer before;
+
+  /// Whether this step is an opacity change. Further opacity changes to
+  /// the same layer join it until [SketchController.endLayerOpacityChange],
+  /// so one slider drag is one step.
+  final bool isOpacity;
+
+  const _LayerSettingsEdit(this.before, {this.isOpacity = false});
+
+  @override
+  bool isCurrent(SketchController controller) =>
+      controller._layerIndex(before.id) >= 0;
+
+  @override
+  void revert(SketchController controller) {
+    final index = controller._layerIndex(before.id);
+    controller.layers[index] = controller.layers[index].copyWith(
+      opacity: before.opacity,
+      visible: before.visible,
+      blendMode: before.blendMode,
+    );
+  }
+}
+
+/// A document that replaced the layers in [before]; undo puts them back,
+/// along with the active layer and the view.
+class _DocumentEdit extends _Edit {
+  final List<SketchLayer> before;
+  final int activeIndex;
+  final Matrix4 view;
+  final int layerId;
+
+  const _DocumentEdit(this.before, this.activeIndex, this.view, this.layerId);
+
+  @override
+  bool isCurrent(SketchController controller) {
+    final layers = controller.layers;
+    return layers.length == 1 && layers.single.id == layerId;
+  }
+
+  @override
+  void revert(SketchController controller) {
+    final loaded = controller.layers.single;
+    for (final stroke in loaded.strokes) {
+      SketchPainter.cleanupStrokeCaches(stroke);
+    }
+    SketchPainter.evictLayerPicture(loaded.id);
+    controller._resetActiveLayerState();
+    controller.layers.assignAll([for (final layer in before) layer.touched()]);
+    controller.activeLayerIndex.value = activeIndex;
+    controller.transformationController.value = view;
+  }
+}
 
 class SketchController extends GetxController {
   SketchController() {
     _saveToHistory();
   }
+
+  /// GetBuilder id of the selection overlay. Lasso and drag updates go only
+  /// to this id, so the stroke layer is not rebuilt while they happen.
+  static const String selectionLayer = 'selection';
+
   // Observable state
-  final strokes = <Stroke>[].obs;
+  /// Layers from the bottom up. Drawing, erasing, lasso and undo work on
+  /// the active layer, whose strokes are [strokes].
+  final layers = <SketchLayer>[SketchLayer(id: 0, name: 'Layer 1')].obs;
+  final activeLayerIndex = 0.obs;
   final undoHistory = <List<Stroke>>[].obs;
   final currentTool = DrawingTool.pencil.obs;
   final currentColor = Colors.black.obs;
   final brushSize = 5.0.obs;
   final toolOpacity = 1.0.obs;
   final currentBrushMode = Rx<BrushMode?>(null);
+  final eraserMode = EraserMode.pixel.obs;
+  final lassoMode = false.obs;
   // Input settings
   final stylusOnlyMode = false.obs; // Palm rejection: ignore touch for drawing
+  // Diagnostics
+  final showPerfOverlay = false.obs;
   // Brush tuning state
   final calligraphyNibAngleDeg = 40.0.obs; // 0–90
   final calligraphyNibWidthFactor = 1.0.obs; // ~0.4–1.8
@@ -30,10 +212,35 @@ class SketchController extends GetxController {
   // Anchored background image destination rect in scene coordinates
   final Rx<Rect?> imageRect = Rx<Rect?>(null);
 
+  int _nextLayerId = 1;
+
   // Current stroke being drawn
   Stroke? _currentStroke;
   List<DrawingPoint> _currentPoints = [];
 
+  // Segment grid over the visible strokes, for the vector and object
+  // erasers; synced with [strokes] before each use.
+  final StrokeIndex _strokeIndex = StrokeIndex();
+  final List<_Edit> _edits = [];
+  static const int _maxEdits = 50;
+  // Whether further opacity changes join the last step, until the slider
+  // drag that started it ends
+  bool _opacityStepOpen = false;
+  // Strokes as they were when the current object erase started
+  List<Stroke>? _objectEraseBefore;
+
+  // Lasso selection, and the transform of a selection drag in progress
+  final List<Offset> _lassoPath = [];
+  List<Stroke> _selection = const <Stroke>[];
+  List<Stroke> _unselected = const <Stroke>[];
+  Rect? _selectionBounds;
+  bool _transformingSelection = false;
+  Offset _selectionOffset = Offset.zero;
+  double _selectionScale = 1.0;
+  double _selectionRotation = 0.0;
+  static const double _minSelectionScale = 0.05;
+  static const double _maxSelectionScale = 20.0;
+
   // Velocity and pressure tracking
   double _lastVelocity = 0.0;
   // Per-tool settings
@@ -82,11 +289,14 @@ class SketchController extends GetxController {
   @override
   void onClose() {
     transformationController.dispose();
+    // Layer pictures are cached statically; they belong to this drawing
+    SketchPainter.clearLayerPictures();
     super.onClose();
   }
 
   // Tool management
   void setTool(DrawingTool tool) {
+    if (lassoMode.value) setLassoMode(false);
     currentTool.value = tool;
     final config = ToolConfig.configs[tool]!;
 
@@ -112,11 +322,21 @@ class SketchController extends GetxController {
     update();
   }
 
+  void setEraserMode(EraserMode mode) {
+    eraserMode.value = mode;
+    update();
+  }
+
   void setStylusOnlyMode(bool enabled) {
     stylusOnlyMode.value = enabled;
     update();
   }
 
+  void togglePerfOverlay() {
+    showPerfOverlay.value = !showPerfOverlay.value;
+    update();
+  }
+
   void setCalligraphyNibAngle(double degrees) {
     calligraphyNibAngleDeg.value = degrees.clamp(0.0, 90.0);
     if (_currentPoints.isNotEmpty) _updateCurrentStroke();
@@ -162,6 +382,7 @@ class SketchController extends GetxController {
   // Drawing methods
   void startStroke(Offset point, double pressure,
       {double tiltX = 0.0, double tiltY = 0.0}) {
+    if (StallWatchdog.enabled) _noteWatchdog(StrokeOp.startStroke);
     // Phase 3: Error boundary for stroke creation
     try {
       _currentPoints = [];
@@ -178,8 +399,12 @@ class SketchController extends GetxController {
       _lastPointTime = DateTime.now();
       _lastVelocity = 0.0;
 
-      // Initialize current stroke immediately for real-time preview
-      _updateCurrentStroke();
+      if (_isObjectEraser) {
+        _beginObjectErase(point);
+      } else {
+        // Initialize current stroke immediately for real-time preview
+        _updateCurrentStroke();
+      }
 
       update();
     } catch (e) {
@@ -200,6 +425,7 @@ class SketchController extends GetxController {
 
   void addPoint(Offset point, double pressure,
       {double tiltX = 0.0, double tiltY = 0.0}) {
+    if (StallWatchdog.enabled) _noteWatchdog(StrokeOp.addPoint);
     // Phase 3: Error boundary for point addition
     try {
       if (_currentPoints.isEmpty) return;
@@ -223,12 +449,17 @@ class SketchController extends GetxController {
         tiltY: tiltY,
       );
 
+      final previous = _lastOffset;
       _currentPoints.add(drawingPoint);
       _lastOffset = point;
       _lastPointTime = now;
 
-      // Create temporary stroke for real-time preview
-      _updateCurrentStroke();
+      if (_isObjectEraser) {
+        _eraseObjectsAlong(previous, point);
+      } else {
+        // Create temporary stroke for real-time preview
+        _updateCurrentStroke();
+      }
       update();
     } catch (e) {
       debugPrint('Point addition failed: $e');
@@ -238,13 +469,49 @@ class SketchController extends GetxController {
   }
 
   void endStroke() {
+    if (kSketchTrace) {
+      PerfTrace.begin('SketchController.endStroke', <String, Object?>{
+        'tool': currentTool.value.name,
+        'brushMode': currentBrushMode.value?.name ?? 'none',
+        'points': _currentPoints.length,
+        'strokes': strokes.length,
+      });
+    }
+    final metricsClock = RunnerMetrics.enabled ? (Stopwatch()..start()) : null;
+    if (StallWatchdog.enabled) _noteWatchdog(StrokeOp.endStroke);
     // Phase 3: Error boundary for stroke completion
     try {
       if (_currentPoints.isEmpty) return;
 
+      if (_isObjectEraser) {
+        _endObjectErase();
+        _currentPoints = [];
+        update();
+        if (metricsClock != null) {
+          RunnerMetrics.record(
+              MetricHistogram.endStrokeUs, metricsClock.elapsedMicroseconds);
+          RunnerMetrics.set(MetricGauge.strokeCount, strokes.length);
+        }
+        return;
+      }
+
       // Smooth the final stroke
       final smoothedPoints = _smoothPoints(_currentPoints);
 
+      if (currentTool.value == DrawingTool.eraser &&
+          eraserMode.value == EraserMode.vector) {
+        _eraseAlong(smoothedPoints, _calculateDynamicWidth() / 2);
+        _currentStroke = null;
+        _currentPoints = [];
+        update();
+        if (metricsClock != null) {
+          RunnerMetrics.record(
+              MetricHistogram.endStrokeUs, metricsClock.elapsedMicroseconds);
+          RunnerMetrics.set(MetricGauge.strokeCount, strokes.length);
+        }
+        return;
+      }
+
       final config = ToolConfig.configs[currentTool.value]!;
       final finalStroke = Stroke(
         points: smoothedPoints,
@@ -265,6 +532,7 @@ class SketchController extends GetxController {
       );
 
       strokes.add(finalStroke);
+      _pushEdit(_AppendEdit(activeLayer.id, finalStroke));
       _currentStroke = null;
       _currentPoints = [];
 
@@ -273,6 +541,13 @@ class SketchController extends GetxController {
 
       _saveToHistory();
       update();
+
+      if (metricsClock != null) {
+        RunnerMetrics.record(
+            MetricHistogram.endStrokeUs, metricsClock.elapsedMicroseconds);
+        RunnerMetrics.add(MetricCounter.strokesCommitted);
+        RunnerMetrics.set(MetricGauge.strokeCount, strokes.length);
+      }
     } catch (e) {
       debugPrint('Stroke completion failed: $e');
       // Graceful recovery: clean up current stroke state
@@ -288,7 +563,67 @@ class SketchController extends GetxController {
       );
 
       update(); // Ensure UI updates even on error
+    } finally {
+      if (kSketchTrace) PerfTrace.end();
+    }
+  }
+
+  /// Cuts the strokes under the eraser path [points] of half-width [radius]
+  /// and swaps in their fragments; the eraser itself is not kept.
+  void _eraseAlong(List<DrawingPoint> points, double radius) {
+    _strokeIndex.sync(strokes, where: _isIndexable);
+    final before = List<Stroke>.of(strokes);
+    final after = VectorEraser.apply(
+      before,
+      [for (final point in points) point.offset],
+      radius,
+      _strokeIndex,
+      onRemoved: SketchPainter.cleanupStrokeCaches,
+    );
+    if (after == null) return;
+
+    strokes.assignAll(after);
+    _pushEdit(_StrokeEdit(activeLayer.id, before, after));
+    _saveToHistory();
+  }
+
+  static bool _isIndexable(Stroke stroke) => !stroke.isEraser;
+
+  bool get _isObjectEraser =>
+      currentTool.value == DrawingTool.eraser &&
+      eraserMode.value == EraserMode.object;
+
+  void _beginObjectErase(Offset point) {
+    _strokeIndex.sync(strokes, where: _isIndexable);
+    _objectEraseBefore = List<Stroke>.of(strokes);
+    _eraseObjectsAlong(point, point);
+  }
+
+  /// Deletes every stroke the eraser touches on its way from [from] to [to].
+  void _eraseObjectsAlong(Offset from, Offset to) {
+    final hits =
+        _strokeIndex.strokesTouching(from, to, _calculateDynamicWidth() / 2);
+    if (hits.isEmpty) return;
+    for (final stroke in hits) {
+      _strokeIndex.remove(stroke);
+      SketchPainter.cleanupStrokeCaches(stroke);
     }
+    strokes.removeWhere(hits.contains);
+  }
+
+  /// Makes the strokes deleted during one object erase a single undo step.
+  void _endObjectErase() {
+    final before = _objectEraseBefore;
+    _objectEraseBefore = null;
+    if (before == null || before.length == strokes.length) return;
+    _pushEdit(_StrokeEdit(activeLayer.id, before, List<Stroke>.of(strokes)));
+    _saveToHistory();
+  }
+
+  void _pushEdit(_Edit edit) {
+    _opacityStepOpen = false;
+    _edits.add(edit);
+    if (_edits.length > _maxEdits) _edits.removeAt(0);
   }
 
   void _updateCurrentStroke() {
@@ -362,12 +697,326 @@ class SketchController extends GetxController {
     return smoothed;
   }
 
+  /// Tells the stall watchdog what the UI thread is about to do.
+  void _noteWatchdog(StrokeOp op) {
+    StallWatchdog.note(op,
+        strokes: strokes.length,
+        points: _currentPoints.length,
+        tool: currentTool.value,
+        brushMode: currentBrushMode.value);
+  }
+
   // Get current stroke for real-time preview
   Stroke? get currentStroke => _currentStroke;
 
+  // Layers
+
+  SketchLayer get activeLayer => layers[activeLayerIndex.value];
+
+  /// Committed strokes of the active layer.
+  RxList<Stroke> get strokes => activeLayer.strokes;
+
+  /// Strokes of every layer, bottom layer first.
+  List<Stroke> get allStrokes => [
+        for (final layer in layers) ...layer.strokes,
+      ];
+
+  /// Adds an empty layer above the active one and makes it active.
+  void addLayer() {
+    final id = _nextLayerId++;
+    final index = activeLayerIndex.value + 1;
+    layers.insert(
+        index, SketchLayer(id: id, name: 'Layer ${layers.length + 1}'));
+    _pushEdit(_LayerAddEdit(id, activeLayer.id));
+    _saveToHistory();
+    setActiveLayer(index);
+  }
+
+  /// Deletes the layer at [index] as one undo step; the last layer is
+  /// never removed.
+  void removeLayer(int index) {
+    if (layers.length < 2 || index < 0 || index >= layers.length) return;
+    _pushEdit(_LayerRemoveEdit(
+        layers[index], index, index == activeLayerIndex.value));
+    _removeLayerAt(index);
+    _saveToHistory();
+    update();
+  }
+
+  void _removeLayerAt(int index) {
+    if (index == activeLayerIndex.value) _resetActiveLayerState();
+    final removed = layers.removeAt(index);
+    for (final stroke in removed.strokes) {
+      SketchPainter.cleanupStrokeCaches(stroke);
+    }
+    SketchPainter.evictLayerPicture(removed.id);
+    final active = activeLayerIndex.value;
+    if (index < active || active >= layers.length) {
+      activeLayerIndex.value = active - 1;
+    }
+  }
+
+  /// Makes the layer at [index] the one drawn on. The layer left behind
+  /// is marked changed, since its strokes were painted live while it was
+  /// active and any picture of it may be stale.
+  void setActiveLayer(int index) {
+    if (index < 0 || index >= layers.length) return;
+    if (index == activeLayerIndex.value) return;
+    _resetActiveLayerState();
+    final previous = activeLayerIndex.value;
+    if (previous < layers.length) layers[previous] = layers[previous].touched();
+    activeLayerIndex.value = index;
+    update();
+  }
+
+  void setLayerOpacity(int index, double opacity) {
+    _replaceLayer(
+        index, (layer) => layer.copyWith(opacity: opacity.clamp(0.0, 1.0)),
+        isOpacity: true);
+  }
+
+  void setLayerVisible(int index, bool visible) {
+    _replaceLayer(index, (layer) => layer.copyWith(visible: visible));
+  }
+
+  void setLayerBlendMode(int index, BlendMode blendMode) {
+    _replaceLayer(index, (layer) => layer.copyWith(blendMode: blendMode));
+  }
+
+  /// Ends the opacity change in progress, so the next one is a new undo
+  /// step. Call it when a slider drag ends.
+  void endLayerOpacityChange() {
+    _opacityStepOpen = false;
+  }
+
+  /// Applies a settings [change] to the layer at [index] as an undo step.
+  void _replaceLayer(int index, SketchLayer Function(SketchLayer) change,
+      {bool isOpacity = false}) {
+    if (index < 0 || index >= layers.length) return;
+    final before = layers[index];
+    final after = change(before);
+    if (after.opacity == before.opacity &&
+        after.visible == before.visible &&
+        after.blendMode == before.blendMode) {
+      return;
+    }
+    final last = _edits.isEmpty ? null : _edits.last;
+    final joins = isOpacity &&
+        _opacityStepOpen &&
+        last is _LayerSettingsEdit &&
+        last.isOpacity &&
+        last.before.id == before.id;
+    if (!joins) _pushEdit(_LayerSettingsEdit(before, isOpacity: isOpacity));
+    _opacityStepOpen = isOpacity;
+    layers[index] = after;
+    update();
+  }
+
+  int _layerIndex(int id) => layers.indexWhere((layer) => layer.id == id);
+
+  SketchLayer? _layerById(int id) {
+    final index = _layerIndex(id);
+    return index < 0 ? null : layers[index];
+  }
+
+  /// Marks the layer [id] changed after its strokes were edited behind the
+  /// painter's back.
+  void _touchLayer(int id) {
+    final index = _layerIndex(id);
+    if (index >= 0) layers[index] = layers[index].touched();
+  }
+
+  // Selection, erase and live-stroke state all refer to the active
+  // layer's strokes, so they end when another layer becomes active.
+  void _resetActiveLayerState() {
+    clearSelection();
+    _objectEraseBefore = null;
+    _currentStroke = null;
+    _currentPoints = [];
+  }
+
+  // Lasso selection
+
+  void setLassoMode(bool enabled) {
+    lassoMode.value = enabled;
+    if (!enabled) clearSelection();
+    update();
+    update([selectionLayer]);
+  }
+
+  List<Offset> get lassoPath => _lassoPath;
+
+  /// Selected strokes, in document order.
+  List<Stroke> get selection => _selection;
+
+  bool get hasSelection => _selection.isNotEmpty;
+
+  /// Inked bounds of the selection before the current transform.
+  Rect? get selectionBounds => _selectionBounds;
+
+  bool get isTransformingSelection => _transformingSelection;
+
+  /// Every stroke but the selection, for the stroke layer during a drag.
+  List<Stroke> get unselectedStrokes => _unselected;
+
+  /// The drag so far: scale and rotation about the selection's centre,
+  /// then the move.
+  Matrix4 get selectionTransform {
+    final pivot = _selectionBounds?.center ?? Offset.zero;
+    return Matrix4.translationValues(
+        pivot.dx + _selectionOffset.dx, pivot.dy + _selectionOffset.dy, 0)
+      ..multiply(Matrix4.rotationZ(_selectionRotation))
+      ..multiply(
+          Matrix4.diagonal3Values(_selectionScale, _selectionScale, 1.0))
+      ..multiply(Matrix4.translationValues(-pivot.dx, -pivot.dy, 0));
+  }
+
+  void beginLasso(Offset point) {
+    clearSelection();
+    _lassoPath.add(point);
+    update([selectionLayer]);
+  }
+
+  void extendLasso(Offset point) {
+    if (_lassoPath.isEmpty) return;
+    _lassoPath.add(point);
+    update([selectionLayer]);
+  }
+
+  /// Closes the lasso and selects the strokes inside it.
+  void endLasso() {
+    if (_lassoPath.isEmpty) return;
+    _select(Lasso.select(strokes, _lassoPath));
+    _lassoPath.clear();
+    update([selectionLayer]);
+  }
+
+  void clearSelection() {
+    _select(const <Stroke>[]);
+    _lassoPath.clear();
+    _endSelectionTransform();
+    update([selectionLayer]);
+  }
+
+  /// Starts dragging the selection. The stroke layer is rebuilt once
+  /// without it; after that only the selection overlay repaints.
+  void beginSelectionTransform() {
+    if (_selection.isEmpty || _transformingSelection) return;
+    final selected = Set<Stroke>.identity()..addAll(_selection);
+    _unselected = [
+      for (final stroke in strokes)
+        if (!selected.contains(stroke)) stroke,
+    ];
+    _transformingSelection = true;
+    update();
+    update([selectionLayer]);
+  }
+
+  /// Places the selection [offset] from where the drag started, scaled by
+  /// [scale] and rotated by [rotation] radians about its centre.
+  void setSelectionTransform({
+    Offset offset = Offset.zero,
+    double scale = 1.0,
+    double rotation = 0.0,
+  }) {
+    if (!_transformingSelection) return;
+    _selectionOffset = offset;
+    _selectionScale = scale.clamp(_minSelectionScale, _maxSelectionScale);
+    _selectionRotation = rotation;
+    update([selectionLayer]);
+  }
+
+  /// Ends the drag by applying its transform to the selected strokes'
+  /// points, as one undo step. The selection stays on the moved strokes.
+  void commitSelectionTransform() {
+    if (!_transformingSelection) return;
+    if (_selectionOffset == Offset.zero &&
+        _selectionScale == 1.0 &&
+        _selectionRotation == 0.0) {
+      cancelSelectionTransform();
+      return;
+    }
+    final matrix = selectionTransform;
+    final scale = _selectionScale;
+    final moved = Map<Stroke, Stroke>.identity();
+    for (final stroke in _selection) {
+      moved[stroke] = stroke.copyWith(
+        points: [
+          for (final point in stroke.points)
+            DrawingPoint(
+              offset: MatrixUtils.transformPoint(matrix, point.offset),
+              pressure: point.pressure,
+              timestamp: point.timestamp,
+              tiltX: point.tiltX,
+              tiltY: point.tiltY,
+            ),
+        ],
+        width: stroke.width * scale,
+      );
+    }
+    final before = List<Stroke>.of(strokes);
+    final after = [for (final stroke in before) moved[stroke] ?? stroke];
+    strokes.assignAll(after);
+    for (final stroke in moved.keys) {
+      SketchPainter.cleanupStrokeCaches(stroke);
+    }
+    _pushEdit(_StrokeEdit(activeLayer.id, before, after));
+    _saveToHistory();
+
+    _select([for (final stroke in _selection) moved[stroke]!]);
+    _endSelectionTransform();
+    update([selectionLayer]);
+  }
+
+  /// Drops the drag and leaves the selection where it was.
+  void cancelSelectionTransform() {
+    _endSelectionTransform();
+    update([selectionLayer]);
+  }
+
+  void _select(List<Stroke> selection) {
+    _selection = selection;
+    Rect? bounds;
+    for (final stroke in selection) {
+      if (stroke.points.isEmpty) continue;
+      final inked = pointBounds(stroke.points).inflate(stroke.width / 2);
+      bounds = bounds == null ? inked : bounds.expandToInclude(inked);
+    }
+    _selectionBounds = bounds;
+  }
+
+  void _endSelectionTransform() {
+    _selectionOffset = Offset.zero;
+    _selectionScale = 1.0;
+    _selectionRotation = 0.0;
+    if (!_transformingSelection) return;
+    _transformingSelection = false;
+    _unselected = const <Stroke>[];
+    update();
+  }
+
   // Undo/Redo functionality
   void undo() {
-    print('🔄 UNDO: Called - strokes.length = ${strokes.length}');
+    if (kSketchLog) {
+      SketchLog.log('undo', 'called', <String, Object?>{
+        'strokes': strokes.length,
+      });
+    }
+    if (StallWatchdog.enabled) _noteWatchdog(StrokeOp.undo);
+    clearSelection();
+    _opacityStepOpen = false;
+    // Steps on any layer undo in the order they were taken
+    while (_edits.isNotEmpty) {
+      final edit = _edits.removeLast();
+      if (!edit.isCurrent(this)) continue;
+      _currentStroke = null;
+      _currentPoints = [];
+      _lastVelocity = 0.0;
+      edit.revert(this);
+      _saveToHistory();
+      update();
+      return;
+    }
     if (strokes.isNotEmpty) {
       final removedStroke = strokes.last;
       strokes.removeLast();
@@ -383,8 +1032,26 @@ class SketchController extends GetxController {
     } else {}
   }
 
+  /// Whether [strokes] holds exactly [list], stroke for stroke.
+  static bool _sameStrokes(List<Stroke> strokes, List<Stroke> list) {
+    if (list.length != strokes.length) return false;
+    for (int i = 0; i < list.length; i++) {
+      if (!identical(list[i], strokes[i])) return false;
+    }
+    return true;
+  }
+
+  /// Erases every layer; the layers themselves stay.
   void clear() {
-    strokes.clear();
+    if (StallWatchdog.enabled) _noteWatchdog(StrokeOp.clear);
+    for (int i = 0; i < layers.length; i++) {
+      layers[i].strokes.clear();
+      layers[i] = layers[i].touched();
+    }
+    _edits.clear();
+    _strokeIndex.clear();
+    _objectEraseBefore = null;
+    clearSelection();
     _currentStroke = null;
     _currentPoints = [];
     _lastVelocity = 0.0;
@@ -398,6 +1065,29 @@ class SketchController extends GetxController {
     update();
   }
 
+  /// Replaces the canvas with [document], on a single layer, and resets the
+  /// zoom. This is one undo step: undo brings back the layers it replaced.
+  void loadDocument(SketchDocument document) {
+    if (StallWatchdog.enabled) _noteWatchdog(StrokeOp.loadDocument);
+    final id = _nextLayerId++;
+    _pushEdit(_DocumentEdit(List<SketchLayer>.of(layers),
+        activeLayerIndex.value, transformationController.value.clone(), id));
+    _resetActiveLayerState();
+    layers.assignAll([
+      SketchLayer(
+          id: id, name: 'Layer 1', strokes: document.strokes.toList().obs),
+    ]);
+    activeLayerIndex.value = 0;
+    _strokeIndex.clear();
+    _lastVelocity = 0.0;
+
+    SketchPainter.clearStrokeCache();
+    SketchPainter.clearBoundsCache();
+
+    _saveToHistory();
+    resetZoom();
+  }
+
   void _saveToHistory() {
     undoHistory.add(List<Stroke>.from(strokes));
     if (undoHistory.length > 50) {
@@ -441,6 +1131,10 @@ class SketchController extends GetxController {
 
   /// Comprehensive memory management called after each stroke
   void _handleMemoryManagement() {
+    if (kSketchTrace) {
+      PerfTrace.begin('SketchController._handleMemoryManagement',
+          <String, Object?>{'strokes': strokes.length});
+    }
     try {
       final strokeCount = strokes.length;
 
@@ -467,6 +1161,8 @@ class SketchController extends GetxController {
     } catch (e) {
       debugPrint('❌ Memory management failed: $e');
       // Don't show user notification for internal memory management failures
+    } finally {
+      if (kSketchTrace) PerfTrace.end();
     }
   }
 
@@ -483,7 +1179,7 @@ class SketchController extends GetxController {
   /// Check current memory usage status
   void checkMemoryStatus() {
     try {
-      final status = MemoryManager.getMemoryStatus(strokes);
+      final status = MemoryManager.getMemoryStatus(allStrokes);
       debugPrint('🧠 Memory Status: $status');
 
       // Show status to user if concerning
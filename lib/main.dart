@@ -1,11 +1,31 @@
+import 'dart:developer' show Timeline;
 import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
 import 'package:flutter/services.dart';
 import 'package:get/get.dart';
 import 'controllers/sketch_controller.dart';
+import 'painters/sketch_painter.dart';
+import 'utils/benchmark_mode.dart';
+import 'utils/brush_textures.dart';
+import 'utils/document_channel.dart';
+import 'utils/headless_render.dart';
+import 'utils/input_replayer.dart';
+import 'utils/runner_metrics.dart';
+import 'utils/stall_watchdog.dart';
+import 'utils/startup_trace.dart';
 import 'widgets/drawing_canvas.dart';
 
-void main() {
+void main(List<String> args) {
+  final mainMicros = Timeline.now;
   WidgetsFlutterBinding.ensureInitialized();
+  StartupTrace.mark('dart_main', mainMicros);
+
+  // Batch rendering from the headless Linux runner: no UI at all
+  final headless = HeadlessRenderOptions.fromArgs(args);
+  if (headless != null) {
+    runHeadlessRender(headless);
+    return;
+  }
 
   // Ensure a clean state for hot restarts/tests
   if (Get.isRegistered<SketchController>()) {
@@ -29,10 +49,44 @@ void main() {
     ),
   );
 
+  // Grain tiles upload in the background; brushes draw procedural grain
+  // until then, and strokes cached before that are redrawn with textures
+  BrushTextures.load().then((_) {
+    SketchPainter.clearStrokeCache();
+    if (Get.isRegistered<SketchController>()) {
+      Get.find<SketchController>().update();
+    }
+  });
+
+  // Production telemetry on the Linux runner (dumped on SIGUSR1)
+  if (RunnerMetrics.enabled) {
+    SchedulerBinding.instance.addTimingsCallback(_reportFrameMetrics);
+  }
+
+  // UI-thread stall log on the Linux runner (--watchdog-ms, default 100)
+  StallWatchdog.start();
+
+  // Nightly perf runs: --benchmark=<session> [--benchmark-out=<json>]
+  final benchmark = BenchmarkOptions.fromArgs(args);
+  if (benchmark != null) {
+    runBenchmark(benchmark, (replay) => SketchApp(replay: replay));
+    return;
+  }
+
   runApp(SketchApp());
 }
 
+void _reportFrameMetrics(List<FrameTiming> timings) {
+  RunnerMetrics.recordFrameTimings(timings);
+  RunnerMetrics.set(
+      MetricGauge.cachedImageBytes, SketchPainter.cachedImageBytes);
+}
+
 class SketchApp extends StatelessWidget {
+  final CanvasReplay? replay;
+
+  SketchApp({this.replay});
+
   @override
   Widget build(BuildContext context) {
     return GetMaterialApp(
@@ -47,7 +101,7 @@ class SketchApp extends StatelessWidget {
           foregroundColor: Colors.black,
         ),
       ),
-      home: const SketchScreen(),
+      home: SketchScreen(replay: replay),
       initialBinding: SketchBinding(),
     );
   }
@@ -56,17 +110,20 @@ class SketchApp extends StatelessWidget {
 class SketchBinding extends Bindings {
   @override
   void dependencies() {
-    Get.put<SketchController>(SketchController());
+    final controller = Get.put<SketchController>(SketchController());
+    DocumentChannel.attach(controller);
   }
 }
 
 class SketchScreen extends StatelessWidget {
-  const SketchScreen({Key? key}) : super(key: key);
+  final CanvasReplay? replay;
+
+  const SketchScreen({Key? key, this.replay}) : super(key: key);
 
   @override
   Widget build(BuildContext context) {
-    return const Scaffold(
-      body: DrawingCanvas(),
+    return Scaffold(
+      body: DrawingCanvas(replay: replay),
     );
   }
 
@@ -0,0 +1,7 @@
+/// How the eraser removes ink.
+///
+/// [pixel] commits the eraser as a `BlendMode.clear` stroke painted over
+/// what is below it. [vector] commits nothing and instead cuts the pen,
+/// pencil and marker strokes it crosses into shorter fragments. [object]
+/// deletes every stroke it touches, whole, as the pointer moves.
+enum EraserMode { pixel, vector, object }
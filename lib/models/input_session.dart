@@ -0,0 +1,241 @@
+import 'dart:typed_data';
+import 'dart:ui' show Offset, PointerDeviceKind, Size;
+
+/// What a recorded [InputEvent] represents.
+enum InputEventType {
+  down,
+  move,
+  up,
+  cancel,
+  tool,
+  brushMode,
+  brushSize,
+  color,
+  opacity,
+  view,
+  eraserMode,
+  lassoMode,
+  addLayer,
+  removeLayer,
+  activeLayer,
+  layerOpacity,
+  layerVisible,
+  layerBlendMode,
+}
+
+/// One recorded pointer event or canvas setting change.
+///
+/// Pointer events carry the `Listener`-local position so replay goes through
+/// the same scene transform as live input. Setting changes keep their value
+/// in [value]: tool / brush / eraser mode index (-1 for no brush mode), ARGB
+/// color, size, opacity or 1 for lasso on. A [InputEventType.view] event
+/// stores the zoom in [value] and the pan in [position]. Layer events name
+/// the layer by its position in [layer] and keep their setting in [value]:
+/// opacity, 1 for visible, or the `BlendMode` index.
+class InputEvent {
+  final InputEventType type;
+  final int timeMicros; // since the start of the session
+  final int pointer;
+  final PointerDeviceKind kind;
+  final int pointerCount; // pointers down before this event
+  final Offset position;
+  final double pressure;
+  final double orientation;
+  final double value;
+  final int layer;
+
+  const InputEvent({
+    required this.type,
+    required this.timeMicros,
+    this.pointer = 0,
+    this.kind = PointerDeviceKind.touch,
+    this.pointerCount = 0,
+    this.position = Offset.zero,
+    this.pressure = 1.0,
+    this.orientation = 0.0,
+    this.value = 0.0,
+    this.layer = 0,
+  });
+
+  bool get isPointer => type.index <= InputEventType.cancel.index;
+
+  bool get isLayer => type.index >= InputEventType.addLayer.index;
+}
+
+/// A recorded drawing session: pointer input plus tool and brush changes.
+///
+/// [toBytes] / [InputSession.fromBytes] use a compact little-endian format:
+/// a 17-byte header ('SKIS', version, canvas size, event count), then per
+/// event a type byte and a µs delta, followed by 20 bytes for pointer
+/// events, 8 for setting changes, 12 for view changes or 10 for layer
+/// events. Version 2 added the eraser, lasso and layer events; version 1
+/// files still read.
+class InputSession {
+  static const int version = 2;
+  static const List<int> _magic = [0x53, 0x4B, 0x49, 0x53]; // SKIS
+
+  final Size canvasSize;
+  final List<InputEvent> events;
+
+  const InputSession({required this.canvasSize, required this.events});
+
+  Duration get duration => Duration(
+      microseconds: events.isEmpty ? 0 : events.last.timeMicros);
+
+  int get strokeCount =>
+      events.where((e) => e.type == InputEventType.down).length;
+
+  Uint8List toBytes() {
+    final builder = BytesBuilder(copy: false);
+    final header = ByteData(17);
+    for (int i = 0; i < _magic.length; i++) {
+      header.setUint8(i, _magic[i]);
+    }
+    header.setUint8(4, version);
+    header.setFloat32(5, canvasSize.width, Endian.little);
+    header.setFloat32(9, canvasSize.height, Endian.little);
+    header.setUint32(13, events.length, Endian.little);
+    builder.add(header.buffer.asUint8List());
+
+    int previous = 0;
+    for (final event in events) {
+      final delta = (event.timeMicros - previous).clamp(0, 0xFFFFFFFF);
+      previous = event.timeMicros;
+      final data = ByteData(5 + _payloadSize(event.type));
+      data.setUint8(0, event.type.index);
+      data.setUint32(1, delta, Endian.little);
+      if (event.isPointer) {
+        data.setUint16(5, event.pointer & 0xFFFF, Endian.little);
+        data.setUint8(7, event.kind.index);
+        data.setUint8(8, event.pointerCount.clamp(0, 255));
+        data.setFloat32(9, event.position.dx, Endian.little);
+        data.setFloat32(13, event.position.dy, Endian.little);
+        data.setFloat32(17, event.pressure, Endian.little);
+        data.setFloat32(21, event.orientation, Endian.little);
+      } else if (event.type == InputEventType.view) {
+        data.setFloat32(5, event.value, Endian.little);
+        data.setFloat32(9, event.position.dx, Endian.little);
+        data.setFloat32(13, event.position.dy, Endian.little);
+      } else if (event.isLayer) {
+        data.setUint16(5, event.layer & 0xFFFF, Endian.little);
+        data.setFloat64(7, event.value, Endian.little);
+      } else {
+        data.setFloat64(5, event.value, Endian.little);
+      }
+      builder.add(data.buffer.asUint8List());
+    }
+    return builder.takeBytes();
+  }
+
+  /// Parses bytes written by [toBytes]; throws [FormatException] otherwise.
+  factory InputSession.fromBytes(Uint8List bytes) {
+    final data = ByteData.sublistView(bytes);
+    if (bytes.length < 17) {
+      throw const FormatException('Input session too short');
+    }
+    for (int i = 0; i < _magic.length; i++) {
+      if (data.getUint8(i) != _magic[i]) {
+        throw const FormatException('Not an input session file');
+      }
+    }
+    final fileVersion = data.getUint8(4);
+    if (fileVersion < 1 || fileVersion > version) {
+      throw FormatException('Unsupported input session version $fileVersion');
+    }
+    final canvasSize = Size(
+      data.getFloat32(5, Endian.little),
+      data.getFloat32(9, Endian.little),
+    );
+    final count = data.getUint32(13, Endian.little);
+
+    final events = <InputEvent>[];
+    int offset = 17;
+    int time = 0;
+    for (int i = 0; i < count; i++) {
+      if (offset + 5 > bytes.length) {
+        throw FormatException('Input session truncated at event $i');
+      }
+      final typeIndex = data.getUint8(offset);
+      if (typeIndex >= InputEventType.values.length) {
+        throw FormatException('Unknown input event type $typeIndex');
+      }
+      final type = InputEventType.values[typeIndex];
+      time += data.getUint32(offset + 1, Endian.little);
+      final p = offset + 5;
+      offset = p + _payloadSize(type);
+      if (offset > bytes.length) {
+        throw FormatException('Input session truncated at event $i');
+      }
+
+      if (type.index <= InputEventType.cancel.index) {
+        final kindIndex = data.getUint8(p + 2);
+        events.add(InputEvent(
+          type: type,
+          timeMicros: time,
+          pointer: data.getUint16(p, Endian.little),
+          kind: kindIndex < PointerDeviceKind.values.length
+              ? PointerDeviceKind.values[kindIndex]
+              : PointerDeviceKind.unknown,
+          pointerCount: data.getUint8(p + 3),
+          position: Offset(
+            data.getFloat32(p + 4, Endian.little),
+            data.getFloat32(p + 8, Endian.little),
+          ),
+          pressure: data.getFloat32(p + 12, Endian.little),
+          orientation: data.getFloat32(p + 16, Endian.little),
+        ));
+      } else if (type == InputEventType.view) {
+        events.add(InputEvent(
+          type: type,
+          timeMicros: time,
+          value: data.getFloat32(p, Endian.little),
+          position: Offset(
+            data.getFloat32(p + 4, Endian.little),
+            data.getFloat32(p + 8, Endian.little),
+          ),
+        ));
+      } else if (type.index >= InputEventType.addLayer.index) {
+        events.add(InputEvent(
+          type: type,
+          timeMicros: time,
+          layer: data.getUint16(p, Endian.little),
+          value: data.getFloat64(p + 2, Endian.little),
+        ));
+      } else {
+        events.add(InputEvent(
+          type: type,
+          timeMicros: time,
+          value: data.getFloat64(p, Endian.little),
+        ));
+      }
+    }
+    return InputSession(canvasSize: canvasSize, events: events);
+  }
+
+  static int _payloadSize(InputEventType type) {
+    switch (type) {
+      case InputEventType.down:
+      case InputEventType.move:
+      case InputEventType.up:
+      case InputEventType.cancel:
+        return 20;
+      case InputEventType.view:
+        return 12;
+      case InputEventType.tool:
+      case InputEventType.brushMode:
+      case InputEventType.brushSize:
+      case InputEventType.color:
+      case InputEventType.opacity:
+      case InputEventType.eraserMode:
+      case InputEventType.lassoMode:
+        return 8;
+      case InputEventType.addLayer:
+      case InputEventType.removeLayer:
+      case InputEventType.activeLayer:
+      case InputEventType.layerOpacity:
+      case InputEventType.layerVisible:
+      case InputEventType.layerBlendMode:
+        return 10;
+    }
+  }
+}
@@ -0,0 +1,115 @@
+import 'package:flutter/material.dart';
+import 'stroke.dart';
+import 'drawing_tool.dart';
+import 'brush_mode.dart';
+
+/// A saved drawing: canvas size plus committed strokes.
+///
+/// JSON layout, kept flat so large documents stay small and quick to parse:
+///
+/// ```json
+/// {"version": 1, "width": 1280, "height": 720, "strokes": [
+///   {"tool": "pen", "color": 4278190080, "width": 2.0, "opacity": 1.0,
+///    "blendMode": "srcOver", "points": [x, y, pressure, timestamp, ...]}
+/// ]}
+/// ```
+///
+/// `isEraser`, `brushMode` and the brush tuning fields are written only when
+/// set. Points lose their tilt, which the painters do not use.
+class SketchDocument {
+  static const int formatVersion = 1;
+
+  final Size canvasSize;
+  final List<Stroke> strokes;
+
+  const SketchDocument({required this.canvasSize, required this.strokes});
+
+  Map<String, dynamic> toJson() => <String, dynamic>{
+        'version': formatVersion,
+        'width': canvasSize.width,
+        'height': canvasSize.height,
+        'strokes': strokes.map(_strokeToJson).toList(),
+      };
+
+  /// Throws [FormatException] for anything that is not a valid document.
+  factory SketchDocument.fromJson(Map<String, dynamic> json) {
+    final version = json['version'];
+    if (version != formatVersion) {
+      throw FormatException('Unsupported sketch document version $version');
+    }
+    try {
+      final strokes = (json['strokes'] as List)
+          .map((s) => _strokeFromJson(s as Map<String, dynamic>))
+          .toList();
+      return SketchDocument(
+        canvasSize: Size(
+          (json['width'] as num).toDouble(),
+          (json['height'] as num).toDouble(),
+        ),
+        strokes: strokes,
+      );
+    } on FormatException {
+      rethrow;
+    } catch (e) {
+      throw FormatException('Malformed sketch document: $e');
+    }
+  }
+
+  static Map<String, dynamic> _strokeToJson(Stroke stroke) {
+    final points = <double>[];
+    for (final p in stroke.points) {
+      points
+        ..add(p.offset.dx)
+        ..add(p.offset.dy)
+        ..add(p.pressure)
+        ..add(p.timestamp);
+    }
+    return <String, dynamic>{
+      'tool': stroke.tool.name,
+      'color': stroke.color.value,
+      'width': stroke.width,
+      'opacity': stroke.opacity,
+      'blendMode': stroke.blendMode.name,
+      if (stroke.isEraser) 'isEraser': true,
+      if (stroke.brushMode != null) 'brushMode': stroke.brushMode!.name,
+      if (stroke.calligraphyNibAngleDeg != null)
+        'nibAngle': stroke.calligraphyNibAngleDeg,
+      if (stroke.calligraphyNibWidthFactor != null)
+        'nibWidth': stroke.calligraphyNibWidthFactor,
+      if (stroke.pastelGrainDensity != null)
+        'grainDensity': stroke.pastelGrainDensity,
+      'points': points,
+    };
+  }
+
+  static Stroke _strokeFromJson(Map<String, dynamic> json) {
+    final raw = json['points'] as List;
+    if (raw.length % 4 != 0) {
+      throw const FormatException('Stroke points must be x, y, p, t groups');
+    }
+    final points = <DrawingPoint>[
+      for (int i = 0; i < raw.length; i += 4)
+        DrawingPoint(
+          offset: Offset(
+              (raw[i] as num).toDouble(), (raw[i + 1] as num).toDouble()),
+          pressure: (raw[i + 2] as num).toDouble(),
+          timestamp: (raw[i + 3] as num).toDouble(),
+        ),
+    ];
+    final brushMode = json['brushMode'] as String?;
+    return Stroke(
+      points: points,
+      color: Color(json['color'] as int),
+      width: (json['width'] as num).toDouble(),
+      tool: DrawingTool.values.byName(json['tool'] as String),
+      opacity: (json['opacity'] as num? ?? 1.0).toDouble(),
+      blendMode:
+          BlendMode.values.byName(json['blendMode'] as String? ?? 'srcOver'),
+      isEraser: json['isEraser'] as bool? ?? false,
+      brushMode: brushMode == null ? null : BrushMode.values.byName(brushMode),
+      calligraphyNibAngleDeg: (json['nibAngle'] as num?)?.toDouble(),
+      calligraphyNibWidthFactor: (json['nibWidth'] as num?)?.toDouble(),
+      pastelGrainDensity: (json['grainDensity'] as num?)?.toDouble(),
+    );
+  }
+}
@@ -0,0 +1,65 @@
+import 'package:flutter/material.dart';
+import 'package:get/get.dart';
+import 'stroke.dart';
+
+/// One layer of the drawing: its own strokes, composited over the layers
+/// below with [opacity] and [blendMode].
+///
+/// The stroke list is shared by every copy of a layer. Everything else is
+/// fixed; the controller swaps in a [copyWith] copy to change it, so a
+/// painter can tell a changed layer from an unchanged one by identity.
+/// [revision] moves on whenever the strokes may differ from what a cached
+/// picture of the layer shows.
+class SketchLayer {
+  final int id;
+  final String name;
+  final RxList<Stroke> strokes;
+  final double opacity;
+  final bool visible;
+  final BlendMode blendMode;
+  final int revision;
+
+  SketchLayer({
+    required this.id,
+    required this.name,
+    RxList<Stroke>? strokes,
+    this.opacity = 1.0,
+    this.visible = true,
+    this.blendMode = BlendMode.srcOver,
+    this.revision = 0,
+  }) : strokes = strokes ?? <Stroke>[].obs;
+
+  /// Blend modes offered for layers, in menu order.
+  static const List<BlendMode> blendModes = [
+    BlendMode.srcOver,
+    BlendMode.multiply,
+    BlendMode.screen,
+    BlendMode.overlay,
+    BlendMode.darken,
+    BlendMode.lighten,
+    BlendMode.colorDodge,
+    BlendMode.colorBurn,
+    BlendMode.difference,
+  ];
+
+  SketchLayer copyWith({
+    String? name,
+    double? opacity,
+    bool? visible,
+    BlendMode? blendMode,
+    int? revision,
+  }) {
+    return SketchLayer(
+      id: id,
+      name: name ?? this.name,
+      strokes: strokes,
+      opacity: opacity ?? this.opacity,
+      visible: visible ?? this.visible,
+      blendMode: blendMode ?? this.blendMode,
+      revision: revision ?? this.revision,
+    );
+  }
+
+  /// Copy whose cached picture, if any, is out of date.
+  SketchLayer touched() => copyWith(revision: revision + 1);
+}
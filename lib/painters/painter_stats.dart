@@ -0,0 +1,43 @@
+/// Counters describing the work done by `SketchPainter.paint`.
+///
+/// Per-frame fields are reset at the start of every paint; cache counters
+/// accumulate until [resetCacheCounters] so hit rates stay readable. The
+/// perf overlay resets them when it is shown, so its rates cover the time
+/// it has been open.
+class PainterStats {
+  // Per frame
+  int visibleStrokes = 0;
+  int culledStrokes = 0;
+  int penBatches = 0;
+  int livePoints = 0;
+  int cachedLayers = 0;
+
+  // Cumulative
+  int boundsCacheHits = 0;
+  int boundsCacheMisses = 0;
+  int paintCacheHits = 0;
+  int paintCacheMisses = 0;
+
+  double get boundsCacheHitRate => _rate(boundsCacheHits, boundsCacheMisses);
+  double get paintCacheHitRate => _rate(paintCacheHits, paintCacheMisses);
+
+  void beginFrame() {
+    visibleStrokes = 0;
+    culledStrokes = 0;
+    penBatches = 0;
+    livePoints = 0;
+    cachedLayers = 0;
+  }
+
+  void resetCacheCounters() {
+    boundsCacheHits = 0;
+    boundsCacheMisses = 0;
+    paintCacheHits = 0;
+    paintCacheMisses = 0;
+  }
+
+  static double _rate(int hits, int misses) {
+    final total = hits + misses;
+    return total == 0 ? 0.0 : hits / total;
+  }
+}
@@ -0,0 +1,70 @@
+import 'package:flutter/material.dart';
+import 'dart:ui' as ui;
+
+/// Overlay for lasso selection: the lasso being drawn, the selection box
+/// with its scale/rotate handle, and during a drag the selected strokes.
+///
+/// While dragging, the selection is drawn from [picture], recorded once by
+/// `SketchPainter.recordStrokes` when the drag began, under [transform].
+/// A move then costs one `drawPicture`, not a replay of its points, and the
+/// stroke layer below keeps its raster since it is not repainted.
+class SelectionPainter extends CustomPainter {
+  final ui.Picture? picture;
+  final Matrix4 transform;
+  final Rect? bounds;
+
+  /// Pass a copy: the painter compares old and new paths by length.
+  final List<Offset> lassoPath;
+
+  /// Scene units per screen pixel; outlines and the handle keep their
+  /// screen size at any zoom.
+  final double pixel;
+
+  /// Handle radius in screen pixels.
+  static const double handleRadius = 8.0;
+
+  static const Color _accent = Color(0xFF1E88E5);
+
+  SelectionPainter({
+    this.picture,
+    required this.transform,
+    this.bounds,
+    this.lassoPath = const <Offset>[],
+    this.pixel = 1.0,
+  });
+
+  @override
+  void paint(Canvas canvas, Size size) {
+    final outline = Paint()
+      ..color = _accent
+      ..style = PaintingStyle.stroke
+      ..strokeWidth = pixel * 1.5
+      ..isAntiAlias = true;
+
+    if (lassoPath.length > 1) {
+      canvas.drawPath(Path()..addPolygon(lassoPath, false), outline);
+    }
+
+    final bounds = this.bounds;
+    if (bounds == null) return;
+    canvas.save();
+    canvas.transform(transform.storage);
+    if (picture != null) canvas.drawPicture(picture!);
+    canvas.drawRect(bounds, outline);
+    canvas.restore();
+
+    final handle = MatrixUtils.transformPoint(transform, bounds.bottomRight);
+    canvas.drawCircle(
+        handle, handleRadius * pixel, Paint()..color = Colors.white);
+    canvas.drawCircle(handle, handleRadius * pixel, outline);
+  }
+
+  @override
+  bool shouldRepaint(covariant SelectionPainter oldDelegate) {
+    return !identical(oldDelegate.picture, picture) ||
+        oldDelegate.transform != transform ||
+        oldDelegate.bounds != bounds ||
+        oldDelegate.lassoPath.length != lassoPath.length ||
+        oldDelegate.pixel != pixel;
+  }
+}
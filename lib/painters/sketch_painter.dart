@@ -1,11 +1,23 @@
 import 'package:flutter/material.dart';
 import 'dart:ui' as ui;
 import 'dart:math' as math;
+import 'dart:typed_data';
 import '../models/stroke.dart';
 import '../models/drawing_tool.dart';
 import '../models/brush_mode.dart';
+import '../models/sketch_layer.dart';
+import '../utils/brush_textures.dart';
+import '../utils/stroke_noise.dart';
+import '../utils/image_tracker.dart';
+import '../utils/perf_trace.dart';
+import '../utils/runner_metrics.dart';
+import '../utils/sketch_log.dart';
+import '../utils/startup_trace.dart';
+import 'stroke_paints.dart';
+import 'painter_stats.dart';
 
 class SketchPainter extends CustomPainter {
+  /// Strokes of the active layer, painted live with [currentStroke].
   final List<Stroke> strokes;
   final Stroke? currentStroke;
   final ImageProvider? backgroundImage;
@@ -15,15 +27,40 @@ class SketchPainter extends CustomPainter {
   final Rect? viewport;
   final Rect? anchoredImageRect;
 
+  /// False paints every stroke on its own with fresh paints: no batching
+  /// and no caches. That is the reference the pixel-equivalence harness
+  /// (test/painters/pixel_equivalence_test.dart) holds the fast path to.
+  final bool optimized;
+
+  /// Layers from the bottom up. Each one is composited with its opacity
+  /// and blend mode; the one at [activeLayer] is painted from [strokes],
+  /// the others from a picture recorded once and kept until the layer's
+  /// revision moves on. Empty paints [strokes] as the only layer.
+  final List<SketchLayer> layers;
+  final int activeLayer;
+
   // Performance optimization: cache for stroke bounds
   static final Map<Stroke, Rect> _boundsCache = <Stroke, Rect>{};
   static const int _maxCacheSize = 500;
 
-  // Phase 2: Stroke-level caching for rendered strokes
+  // Phase 2: Stroke-level caching for rendered strokes. Images stored here
+  // must be registered with ImageTracker, which tests check for leaks.
   static final Map<Stroke, ui.Image?> _strokeCache = <Stroke, ui.Image?>{};
   static final Map<Stroke, bool> _strokeDirty = <Stroke, bool>{};
   static const int _maxStrokeCacheSize = 100;
 
+  // Per-stroke paint state, built once and reused across frames
+  static final Map<Stroke, StrokePaints> _paintCache =
+      <Stroke, StrokePaints>{};
+
+  // Recorded pictures of inactive layers, by layer id. Registered with
+  // ImageTracker, so every eviction must dispose.
+  static final Map<int, _LayerPicture> _layerPictures =
+      <int, _LayerPicture>{};
+
+  // Scratch buffer for per-segment texture noise (painting is synchronous)
+  static final Float32List _noise = Float32List(8);
+
   // Phase 1: Airbrush Performance Optimization
   /// Calculate dynamic performance budget based on stroke complexity
   static int _calculateParticleBudget(int pointCount, double strokeWidth) {
@@ -50,20 +87,14 @@ class SketchPainter extends CustomPainter {
 
   /// Draw core stroke foundation to prevent gaps at high drawing speeds
   void _drawAirbrushCore(Canvas canvas, List<DrawingPoint> points,
-      Color baseColor, double opacity, double strokeWidth) {
+      Paint corePaint, double strokeWidth) {
     if (points.length < 2) return;
 
     for (int i = 0; i < points.length - 1; i++) {
       final a = points[i];
       final b = points[i + 1];
-      final corePaint = Paint()
-        ..color = baseColor.withValues(alpha: opacity * 0.15)
-        ..style = PaintingStyle.stroke
-        ..strokeCap = StrokeCap.round
-        ..isAntiAlias = true
-        ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.5)
-        ..strokeWidth =
-            math.max(0.5, (a.pressure + b.pressure) * 0.5 * strokeWidth * 0.4);
+      corePaint.strokeWidth =
+          math.max(0.5, (a.pressure + b.pressure) * 0.5 * strokeWidth * 0.4);
       canvas.drawLine(a.offset, b.offset, corePaint);
     }
   }
@@ -77,28 +108,134 @@ class SketchPainter extends CustomPainter {
     this.backgroundImageData,
     this.viewport,
     this.anchoredImageRect,
+    this.optimized = true,
+    this.layers = const <SketchLayer>[],
+    this.activeLayer = 0,
   });
 
   @override
   void paint(Canvas canvas, Size size) {
+    StartupTrace.firstPaint();
+    if (!kSketchTrace) {
+      _paintScene(canvas, size);
+      return;
+    }
+    PerfTrace.begin('SketchPainter.paint', <String, Object?>{
+      'strokes': strokes.length,
+      'livePoints': currentStroke?.points.length ?? 0,
+    });
+    _paintScene(canvas, size);
+    PerfTrace.end();
+  }
+
+  void _paintScene(Canvas canvas, Size size) {
+    stats.beginFrame();
+
     // Draw background image if available
     if (isImageVisible && backgroundImageData != null) {
       _drawBackgroundImage(canvas, size);
     }
 
+    if (layers.isEmpty) {
+      stats.penBatches = _paintStrokeLayer(canvas, size);
+    } else {
+      _paintLayers(canvas, size);
+    }
+  }
+
+  // Composites every visible layer in order. Only the active layer costs
+  // per-stroke work; the rest are one drawPicture each, so a stroke on one
+  // layer never repaints the strokes of another, and its erasers only
+  // clear that layer's ink.
+  void _paintLayers(Canvas canvas, Size size) {
+    final bounds = Offset.zero & size;
+    // The active layer is painted live, so a picture of it is dead weight
+    if (activeLayer < layers.length) {
+      evictLayerPicture(layers[activeLayer].id);
+    }
+    for (int i = 0; i < layers.length; i++) {
+      final layer = layers[i];
+      if (!layer.visible || layer.opacity <= 0.0) continue;
+      final blended =
+          layer.opacity < 1.0 || layer.blendMode != BlendMode.srcOver;
+      final paint = Paint()
+        ..color = Color.fromRGBO(0, 0, 0, layer.opacity)
+        ..blendMode = layer.blendMode;
+      if (i == activeLayer) {
+        stats.penBatches += _paintStrokeLayer(canvas, size, paint);
+        continue;
+      }
+      final picture = _layerPicture(layer, size);
+      stats.cachedLayers++;
+      if (blended) canvas.saveLayer(bounds, paint);
+      canvas.drawPicture(picture);
+      if (blended) canvas.restore();
+    }
+  }
+
+  // The cached picture of [layer], re-recorded when its revision or the
+  // scene size has changed. Recorded without a viewport so pans reuse it.
+  static ui.Picture _layerPicture(SketchLayer layer, Size size) {
+    final cached = _layerPictures[layer.id];
+    if (cached != null &&
+        cached.revision == layer.revision &&
+        cached.size == size) {
+      return cached.picture;
+    }
+    cached?.picture.dispose();
+    final picture = ImageTracker.picture(
+        recordStrokes(layer.strokes, size), 'SketchPainter.layer');
+    _layerPictures[layer.id] = _LayerPicture(picture, layer.revision, size);
+    return picture;
+  }
+
+  /// Records [strokes] exactly as a scene of [size] would paint them, so a
+  /// selection can be redrawn under a transform without its point data.
+  static ui.Picture recordStrokes(List<Stroke> strokes, Size size) {
+    final recorder = ui.PictureRecorder();
+    SketchPainter(strokes: strokes, isImageVisible: false)
+        ._paintStrokeLayer(Canvas(recorder), size);
+    return recorder.endRecording();
+  }
+
+  // Strokes and the live stroke in their own layer, so erasers clear ink
+  // and not the background; [layerPaint] composites that layer. Returns
+  // the number of pen batch draw calls.
+  int _paintStrokeLayer(Canvas canvas, Size size, [Paint? layerPaint]) {
     // Set up canvas for drawing strokes
-    canvas.saveLayer(Rect.fromLTWH(0, 0, size.width, size.height), Paint());
+    canvas.saveLayer(
+        Rect.fromLTWH(0, 0, size.width, size.height), layerPaint ?? Paint());
 
-    // Draw all completed strokes (with optimized caching)
+    // Draw all completed strokes (with optimized caching). Runs of
+    // compatible pen strokes are merged into one path; any other stroke
+    // (eraser included) flushes the run first so z-order is preserved.
+    final batch = _PenBatch();
     for (final stroke in strokes) {
       if (viewport != null && stroke.points.isNotEmpty) {
-        if (!_isStrokeVisible(stroke)) continue;
+        if (!_isStrokeVisible(stroke)) {
+          stats.culledStrokes++;
+          continue;
+        }
+      }
+      stats.visibleStrokes++;
+      if (optimized && isBatchable(stroke)) {
+        if (!batch.accepts(stroke)) batch.flush(canvas, _paintsFor);
+        batch.add(stroke,
+            _createCatmullRomPath(stroke.points, closed: false, alpha: 0.5));
+        continue;
+      }
+      batch.flush(canvas, _paintsFor);
+      if (optimized) {
+        _drawStrokeOptimized(canvas, stroke);
+      } else {
+        _drawStroke(canvas, stroke);
       }
-      _drawStrokeOptimized(canvas, stroke);
     }
+    batch.flush(canvas, _paintsFor);
 
     // Draw current stroke being drawn (always fresh, no caching)
     if (currentStroke != null) {
+      stats.livePoints = currentStroke!.points.length;
       if (viewport != null && currentStroke!.points.isNotEmpty) {
         // For current stroke, be more generous with culling at high zoom levels
         final strokeBounds = _getBoundingRect(currentStroke!.points);
@@ -113,6 +250,7 @@ class SketchPainter extends CustomPainter {
     }
 
     canvas.restore();
+    return batch.drawCalls;
   }
 
   void _drawBackgroundImage(Canvas canvas, Size size) {
@@ -172,6 +310,9 @@ class SketchPainter extends CustomPainter {
       ..isAntiAlias = true
       ..filterQuality = FilterQuality.high;
 
+    if (kSketchTrace) {
+      PerfTrace.begin(_toolSpans[stroke.tool]!, PerfTrace.strokeArgs(stroke));
+    }
     switch (stroke.tool) {
       case DrawingTool.pencil:
         _drawPencilStroke(canvas, stroke, paint);
@@ -189,8 +330,28 @@ class SketchPainter extends CustomPainter {
         _drawBrushStroke(canvas, stroke, paint);
         break;
     }
+    if (kSketchTrace) PerfTrace.end();
   }
 
+  // Timeline span names, built once so tracing never formats strings
+  static const Map<DrawingTool, String> _toolSpans = {
+    DrawingTool.pencil: 'SketchPainter._drawPencilStroke',
+    DrawingTool.pen: 'SketchPainter._drawPenStroke',
+    DrawingTool.marker: 'SketchPainter._drawMarkerStroke',
+    DrawingTool.eraser: 'SketchPainter._drawEraserStroke',
+    DrawingTool.brush: 'SketchPainter._drawBrushStroke',
+  };
+
+  static const Map<BrushMode?, String> _brushSpans = {
+    null: 'BrushMode.basic',
+    BrushMode.charcoal: 'BrushMode.charcoal',
+    BrushMode.watercolor: 'BrushMode.watercolor',
+    BrushMode.oilPaint: 'BrushMode.oilPaint',
+    BrushMode.airbrush: 'BrushMode.airbrush',
+    BrushMode.calligraphy: 'BrushMode.calligraphy',
+    BrushMode.pastel: 'BrushMode.pastel',
+  };
+
   // Phase 2: Optimized stroke drawing with caching
   void _drawStrokeOptimized(Canvas canvas, Stroke stroke) {
     if (stroke.points.isEmpty) return;
@@ -221,6 +382,68 @@ class SketchPainter extends CustomPainter {
     // For now, we're just tracking dirty state to avoid expensive recomputation
   }
 
+  /// Work counters for the performance overlay and tests
+  static final PainterStats stats = PainterStats();
+
+  /// Number of merged pen draw calls issued by the last [paint] (diagnostics)
+  static int get lastPenBatchCount => stats.penBatches;
+
+  /// Bytes held by rasterized stroke cache entries
+  static int get cachedImageBytes {
+    int total = 0;
+    for (final image in _strokeCache.values) {
+      if (image != null) total += image.width * image.height * 4;
+    }
+    return total;
+  }
+
+  /// Whether [stroke] may be merged with neighbours into a single draw call.
+  ///
+  /// Only opaque `srcOver` pen strokes qualify: merging translucent strokes
+  /// would cover their overlaps once instead of twice and change the result.
+  static bool isBatchable(Stroke stroke) {
+    return stroke.tool == DrawingTool.pen &&
+        !stroke.isEraser &&
+        stroke.points.length > 1 &&
+        stroke.opacity >= 1.0 &&
+        stroke.color.a >= 1.0 &&
+        stroke.blendMode == BlendMode.srcOver;
+  }
+
+  /// Whether two batchable strokes share every paint setting.
+  static bool canBatchTogether(Stroke a, Stroke b) {
+    return a.tool == b.tool &&
+        a.color == b.color &&
+        a.width == b.width &&
+        a.opacity == b.opacity &&
+        a.blendMode == b.blendMode;
+  }
+
+  // Paint state for a stroke. The live stroke is rebuilt on every point, so
+  // it gets fresh paints instead of churning the cache; so does the
+  // reference path.
+  StrokePaints _paintsFor(Stroke stroke) {
+    if (!optimized || identical(stroke, currentStroke)) {
+      return StrokePaints.forStroke(stroke);
+    }
+    final cached = _paintCache[stroke];
+    if (cached != null) {
+      stats.paintCacheHits++;
+      if (RunnerMetrics.enabled) {
+        RunnerMetrics.add(MetricCounter.paintCacheHits);
+      }
+      return cached;
+    }
+    stats.paintCacheMisses++;
+    if (RunnerMetrics.enabled) {
+      RunnerMetrics.add(MetricCounter.paintCacheMisses);
+    }
+    if (_paintCache.length >= _maxCacheSize) {
+      optimizeCaches();
+    }
+    return _paintCache[stroke] = StrokePaints.forStroke(stroke);
+  }
+
   // Static methods for cache management
   static void clearStrokeCache() {
     // CRITICAL: Dispose all cached images before clearing to prevent memory leaks
@@ -229,13 +452,31 @@ class SketchPainter extends CustomPainter {
     }
     _strokeCache.clear();
     _strokeDirty.clear();
+    _paintCache.clear();
+    clearLayerPictures();
   }
 
+  static void clearLayerPictures() {
+    for (final entry in _layerPictures.values) {
+      entry.picture.dispose();
+    }
+    _layerPictures.clear();
+  }
+
+  /// Drops the cached picture of a deleted layer.
+  static void evictLayerPicture(int layerId) {
+    _layerPictures.remove(layerId)?.picture.dispose();
+  }
+
+  /// Number of layers held as recorded pictures
+  static int get cachedLayerCount => _layerPictures.length;
+
   static void invalidateStroke(Stroke stroke) {
     _strokeDirty[stroke] = true;
     // CRITICAL: Dispose cached image before removing to prevent memory leak
     final cachedImage = _strokeCache.remove(stroke);
     cachedImage?.dispose();
+    _paintCache.remove(stroke);
   }
 
   // Phase 4: Enhanced memory management for bounds cache
@@ -273,6 +514,14 @@ class SketchPainter extends CustomPainter {
         _boundsCache.remove(key);
       }
     }
+
+    if (_paintCache.length > _maxCacheSize) {
+      final excess = _paintCache.length - (_maxCacheSize * 3 ~/ 4);
+      final oldestKeys = _paintCache.keys.take(excess).toList();
+      for (final key in oldestKeys) {
+        _paintCache.remove(key);
+      }
+    }
   }
 
   void _drawPencilStroke(Canvas canvas, Stroke stroke, Paint paint) {
@@ -282,7 +531,10 @@ class SketchPainter extends CustomPainter {
       ..blendMode =
           BlendMode.srcOver; // avoid multiply artifacts over bright colors
 
-    final baseColor = paint.color;
+    final paints = _paintsFor(stroke);
+    final linePaint = paints.base;
+    final texturePaint = paints.texture;
+    final seed = StrokeNoise.seedFor(stroke);
 
     // Work on an interpolated set of points to reduce gaps/dots
     final points = _interpolatePoints(stroke.points, maxSegmentLen: 3.0);
@@ -297,6 +549,14 @@ class SketchPainter extends CustomPainter {
       return;
     }
 
+    // Once loaded, the paper tile grains the jitter lines; their geometry
+    // stays the same, so the pencil keeps its look
+    final paper = BrushTextures.shader(BrushTexture.pencilPaper);
+    final jitterPaint = paper == null
+        ? texturePaint
+        : paints.grain(paper,
+            alpha: paints.textureColor.a * 2.0, style: PaintingStyle.stroke);
+
     // Create path with varying width based on pressure
     for (int i = 0; i < points.length - 1; i++) {
       final point1 = points[i];
@@ -307,38 +567,25 @@ class SketchPainter extends CustomPainter {
       final avgWidth = (width1 + width2) / 2;
 
       // Draw main stroke segment with base color
-      paint
-        ..color = baseColor
-        ..strokeWidth = avgWidth;
-      canvas.drawLine(point1.offset, point2.offset, paint);
+      linePaint.strokeWidth = avgWidth;
+      canvas.drawLine(point1.offset, point2.offset, linePaint);
+      jitterPaint.strokeWidth = math.max(0.5, avgWidth * 0.25);
 
       // Add subtle texture lines using low alpha; avoid colored specks on bright colors
-      final random = math.Random(i * 31);
+      final noise = _noise;
+      StrokeNoise.fill(noise, seed, i);
       for (int j = 0; j < 2; j++) {
+        final n = j * 4;
         final offset1 = Offset(
-          point1.offset.dx + random.nextDouble() * 0.5 - 0.25,
-          point1.offset.dy + random.nextDouble() * 0.5 - 0.25,
+          point1.offset.dx + noise[n] * 0.5 - 0.25,
+          point1.offset.dy + noise[n + 1] * 0.5 - 0.25,
         );
         final offset2 = Offset(
-          point2.offset.dx + random.nextDouble() * 0.5 - 0.25,
-          point2.offset.dy + random.nextDouble() * 0.5 - 0.25,
+          point2.offset.dx + noise[n + 2] * 0.5 - 0.25,
+          point2.offset.dy + noise[n + 3] * 0.5 - 0.25,
         );
 
-        final isBright = baseColor.computeLuminance() > 0.7;
-        final textureAlpha = (baseColor.a * 0.18).clamp(0.05, 0.2);
-        final texturePaint = Paint()
-          ..color = isBright
-              ? Colors.black.withValues(alpha: 0.12)
-              : baseColor.withValues(alpha: textureAlpha)
-          ..strokeCap = paint.strokeCap
-          ..strokeJoin = paint.strokeJoin
-          ..blendMode = BlendMode.srcOver
-          ..isAntiAlias = true
-          ..filterQuality = FilterQuality.high
-          ..style = PaintingStyle.stroke
-          ..strokeWidth = math.max(0.5, avgWidth * 0.25);
-
-        canvas.drawLine(offset1, offset2, texturePaint);
+        canvas.drawLine(offset1, offset2, jitterPaint);
       }
     }
   }
@@ -404,35 +651,19 @@ class SketchPainter extends CustomPainter {
 
   void _drawEraserStroke(Canvas canvas, Stroke stroke, Paint paint) {
     // Feathered dstOut eraser: removes stroke alpha softly without hard squares
-    final base = Paint()
-      ..style = PaintingStyle.stroke
-      ..strokeCap = StrokeCap.round
-      ..strokeJoin = StrokeJoin.round
-      ..isAntiAlias = true
-      ..strokeWidth = stroke.width
-      ..blendMode = BlendMode.dstOut
-      ..color = Colors.black.withValues(alpha: 0.95);
-
-    final feather = Paint()
-      ..style = PaintingStyle.stroke
-      ..strokeCap = StrokeCap.round
-      ..strokeJoin = StrokeJoin.round
-      ..isAntiAlias = true
-      ..strokeWidth = stroke.width * 1.5
-      ..blendMode = BlendMode.dstOut
-      ..color = Colors.black.withValues(alpha: 0.35);
+    final paints = _paintsFor(stroke);
+    final base = paints.base;
+    final feather = paints.edge;
 
     if (stroke.points.length == 1) {
+      // Dots need fill style; restore it since these paints are shared
+      feather.style = PaintingStyle.fill;
+      base.style = PaintingStyle.fill;
       canvas.drawCircle(
-        stroke.points.first.offset,
-        (stroke.width * 1.5) / 2,
-        feather..style = PaintingStyle.fill,
-      );
-      canvas.drawCircle(
-        stroke.points.first.offset,
-        stroke.width / 2,
-        base..style = PaintingStyle.fill,
-      );
+          stroke.points.first.offset, (stroke.width * 1.5) / 2, feather);
+      canvas.drawCircle(stroke.points.first.offset, stroke.width / 2, base);
+      feather.style = PaintingStyle.stroke;
+      base.style = PaintingStyle.stroke;
       return;
     }
 
@@ -463,6 +694,16 @@ class SketchPainter extends CustomPainter {
       return;
     }
 
+    // Texture noise is keyed by (stroke, point, k), never by draw order
+    final seed = StrokeNoise.seedFor(stroke);
+
+    if (kSketchTrace) {
+      PerfTrace.begin(
+          _brushSpans[stroke.brushMode]!,
+          PerfTrace.strokeArgs(stroke)
+            ..['interpolatedPoints'] = points.length);
+    }
+
     // If an advanced brush mode is selected, render accordingly
     switch (stroke.brushMode) {
       case null:
@@ -500,25 +741,44 @@ class SketchPainter extends CustomPainter {
       case BrushMode.charcoal:
         // Phase 3: Optimized charcoal with reduced particle count
         final baseColor = paint.color;
-        final dabPaint = Paint()
-          ..style = PaintingStyle.fill
-          ..isAntiAlias = true;
-        for (final p in points) {
+        final paints = _paintsFor(stroke);
+        final dabPaint = paints.base;
+        final grainPaint = paints.texture;
+        final grainShader = BrushTextures.shader(BrushTexture.charcoalGrain);
+        if (grainShader != null) {
+          // One textured dab instead of 3-8 grain particles. Like the
+          // particles it stays inside the dab, and it is laid down only
+          // after the brush moves half a dab, so overlapping grain does not
+          // build up into a solid rim.
+          final grain = paints.grain(grainShader, alpha: stroke.opacity * 0.4);
+          Offset? lastGrain;
+          for (final p in points) {
+            final w = (stroke.width * p.pressure).clamp(0.5, 200.0);
+            canvas.drawCircle(p.offset, w * 0.5, dabPaint);
+            if (lastGrain == null ||
+                (p.offset - lastGrain).distance >= w * 0.5) {
+              canvas.drawCircle(p.offset, w * 0.5, grain);
+              lastGrain = p.offset;
+            }
+          }
+          break;
+        }
+        for (int pi = 0; pi < points.length; pi++) {
+          final p = points[pi];
           final w = (stroke.width * p.pressure).clamp(0.5, 200.0);
-          dabPaint.color = baseColor.withValues(alpha: stroke.opacity * 0.7);
           canvas.drawCircle(p.offset, w * 0.5, dabPaint);
           // Optimized grain: reduced from 6-18 to 3-8 particles
-          final rnd = math.Random(
-              p.offset.dx.toInt() * 73856093 ^ p.offset.dy.toInt() * 19349663);
           final grains = (w / 4).round().clamp(3, 8); // Reduced particle count
           for (int i = 0; i < grains; i++) {
-            final ang = rnd.nextDouble() * 2 * math.pi;
-            final dist = rnd.nextDouble() * w * 0.5;
-            final gSize = rnd.nextDouble() * 1.3 + 0.4;
+            final k = i * 4;
+            final ang = StrokeNoise.unit(seed, pi, k) * 2 * math.pi;
+            final dist = StrokeNoise.unit(seed, pi, k + 1) * w * 0.5;
+            final gSize = StrokeNoise.unit(seed, pi, k + 2) * 1.3 + 0.4;
             final gOff = Offset(math.cos(ang) * dist, math.sin(ang) * dist);
-            final gColor = baseColor.withValues(
-                alpha: stroke.opacity * (0.12 + rnd.nextDouble() * 0.25));
-            canvas.drawCircle(p.offset + gOff, gSize, dabPaint..color = gColor);
+            grainPaint.color = baseColor.withValues(
+                alpha: stroke.opacity *
+                    (0.12 + StrokeNoise.unit(seed, pi, k + 3) * 0.25));
+            canvas.drawCircle(p.offset + gOff, gSize, grainPaint);
           }
         }
         break;
@@ -536,68 +796,30 @@ class SketchPainter extends CustomPainter {
         }
         final path =
             _createCatmullRomPath(stroke.points, closed: false, alpha: 0.5);
-        // Phase 3: Simplified watercolor with reduced layers (3 -> 2)
-        final layers = [
-          {"widthFactor": 1.2, "alpha": 0.22, "blur": 2.5},
-          {"widthFactor": 0.9, "alpha": 0.35, "blur": 1.0},
-        ];
-        for (final layer in layers) {
-          final layerPaint = Paint()
-            ..color = paint.color
-                .withValues(alpha: stroke.opacity * (layer["alpha"] as double))
-            ..style = PaintingStyle.stroke
-            ..strokeCap = StrokeCap.round
-            ..strokeJoin = StrokeJoin.round
-            ..isAntiAlias = true
-            ..maskFilter =
-                MaskFilter.blur(BlurStyle.normal, layer["blur"] as double)
-            ..strokeWidth = stroke.width * (layer["widthFactor"] as double);
-          canvas.drawPath(path, layerPaint);
-        }
+        // Phase 3: Simplified watercolor with reduced layers (3 -> 2):
+        // wide soft wash (edge) under a narrower denser body (base)
+        final paints = _paintsFor(stroke);
+        canvas.drawPath(path, paints.edge);
+        canvas.drawPath(path, paints.base);
         // Optional: subtle bleed at the end point
         final end = stroke.points.last.offset;
-        final bleedPaint = Paint()
-          ..color = paint.color.withValues(alpha: stroke.opacity * 0.12)
-          ..style = PaintingStyle.fill
-          ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 2.0);
-        canvas.drawCircle(end, stroke.width * 0.6, bleedPaint);
+        canvas.drawCircle(end, stroke.width * 0.6, paints.glow);
         break;
       case BrushMode.oilPaint:
         // Oil paint: impasto-like layered stroke with subtle highlight
         {
           final path =
               _createCatmullRomPath(stroke.points, closed: false, alpha: 0.5);
-          final baseColor = paint.color;
+          final paints = _paintsFor(stroke);
 
           // Underpaint: slightly darker, wider, soft
-          final under = Paint()
-            ..color = baseColor.withValues(
-                alpha: (stroke.opacity * 0.22).clamp(0.0, 1.0))
-            ..style = PaintingStyle.stroke
-            ..strokeCap = StrokeCap.round
-            ..strokeJoin = StrokeJoin.round
-            ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 1.5)
-            ..strokeWidth = stroke.width * 1.35;
-          canvas.drawPath(path, under);
+          canvas.drawPath(path, paints.edge);
 
           // Body paint: main opaque body with slight texture variation
-          final body = Paint()
-            ..color =
-                baseColor.withValues(alpha: stroke.opacity.clamp(0.0, 1.0))
-            ..style = PaintingStyle.stroke
-            ..strokeCap = StrokeCap.round
-            ..strokeJoin = StrokeJoin.round
-            ..strokeWidth = stroke.width;
-          canvas.drawPath(path, body);
+          canvas.drawPath(path, paints.base);
 
           // Ridge highlight: lighter sheen along one side based on tangent
-          final highlight = Paint()
-            ..color = Colors.white.withValues(alpha: (stroke.opacity * 0.18))
-            ..style = PaintingStyle.stroke
-            ..strokeCap = StrokeCap.round
-            ..strokeJoin = StrokeJoin.round
-            ..strokeWidth = math.max(1.0, stroke.width * 0.35)
-            ..blendMode = BlendMode.screen;
+          final highlight = paints.glow;
 
           // Approximate highlight by stroking a slightly offset path
           final hlPath = Path();
@@ -619,16 +841,13 @@ class SketchPainter extends CustomPainter {
           canvas.drawPath(hlPath, highlight);
 
           // Occasional thick daubs along the path to simulate impasto
-          final rnd = math.Random(1337);
+          final daub = paints.texture;
           for (int i = 0; i < points.length; i += 6) {
             final p = points[i];
             final w = (stroke.width * p.pressure).clamp(0.8, 200.0);
-            final daub = Paint()
-              ..color = baseColor.withValues(alpha: (stroke.opacity * 0.35))
-              ..style = PaintingStyle.fill;
-            final rx = w * (0.45 + rnd.nextDouble() * 0.25);
-            final ry = w * (0.25 + rnd.nextDouble() * 0.2);
-            final ang = rnd.nextDouble() * math.pi;
+            final rx = w * (0.45 + StrokeNoise.unit(seed, i, 0) * 0.25);
+            final ry = w * (0.25 + StrokeNoise.unit(seed, i, 1) * 0.2);
+            final ang = StrokeNoise.unit(seed, i, 2) * math.pi;
             canvas.save();
             canvas.translate(p.offset.dx, p.offset.dy);
             canvas.rotate(ang);
@@ -643,23 +862,15 @@ class SketchPainter extends CustomPainter {
         // PHASE 1: Industrial-grade airbrush with performance budgeting
         {
           final baseColor = paint.color;
-
-          // Use stroke-consistent seeding to prevent frame-rate variations
-          final strokeHash = stroke.points.fold<int>(
-              0,
-              (hash, p) =>
-                  hash ^
-                  (p.offset.dx.toInt() * 73856093) ^
-                  (p.offset.dy.toInt() * 19349663));
-          final rnd = math.Random(strokeHash);
+          final paints = _paintsFor(stroke);
+          final drop = paints.texture;
 
           // Calculate performance budget
           final maxParticlesPerSegment =
               _calculateParticleBudget(points.length, stroke.width);
 
           // Draw core stroke foundation (prevents gaps at high drawing speeds)
-          _drawAirbrushCore(
-              canvas, points, baseColor, stroke.opacity, stroke.width);
+          _drawAirbrushCore(canvas, points, paints.base, stroke.width);
 
           // Optimized particle generation
           for (int i = 0; i < points.length - 1; i++) {
@@ -675,9 +886,12 @@ class SketchPainter extends CustomPainter {
             final baseCount = (stroke.width * 0.15 * speedFactor)
                 .clamp(2, maxParticlesPerSegment) // Use performance budget
                 .toInt();
+            final perp = _getPerpendicular(a.offset, b.offset);
 
             for (int k = 0; k < baseCount; k++) {
-              final t = rnd.nextDouble();
+              // Six noise values per particle, addressed by (segment, k)
+              final n = k * 6;
+              final t = StrokeNoise.unit(seed, i, n);
               final p = Offset.lerp(a.offset, b.offset, t)!;
 
               // Viewport culling: skip invisible particles
@@ -685,21 +899,18 @@ class SketchPainter extends CustomPainter {
 
               // Rest of particle generation...
               final pr = a.pressure * (1 - t) + b.pressure * t;
-              final radius =
-                  (stroke.width * (0.15 + rnd.nextDouble() * 0.35) * pr)
-                      .clamp(0.4, 6.0);
-              final perp = _getPerpendicular(a.offset, b.offset);
-              final spread = stroke.width * (0.6 + rnd.nextDouble() * 0.8);
-              final jitter =
-                  (rnd.nextDouble() - 0.5) + (rnd.nextDouble() - 0.5);
+              final sizeNoise = StrokeNoise.unit(seed, i, n + 1);
+              final radius = (stroke.width * (0.15 + sizeNoise * 0.35) * pr)
+                  .clamp(0.4, 6.0);
+              final spreadNoise = StrokeNoise.unit(seed, i, n + 2);
+              final spread = stroke.width * (0.6 + spreadNoise * 0.8);
+              final jitter = (StrokeNoise.unit(seed, i, n + 3) - 0.5) +
+                  (StrokeNoise.unit(seed, i, n + 4) - 0.5);
               final offset = perp * (jitter * spread);
 
-              final drop = Paint()
-                ..color = baseColor.withValues(
-                    alpha: stroke.opacity * (0.05 + rnd.nextDouble() * 0.22))
-                ..style = PaintingStyle.fill
-                ..isAntiAlias = true
-                ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.8);
+              drop.color = baseColor.withValues(
+                  alpha: stroke.opacity *
+                      (0.05 + StrokeNoise.unit(seed, i, n + 5) * 0.22));
               canvas.drawCircle(p + offset, radius, drop);
             }
           }
@@ -708,11 +919,15 @@ class SketchPainter extends CustomPainter {
       case BrushMode.calligraphy:
         // Calligraphy: flat nib with fixed angle causing thick/thin variation
         {
-          final baseColor = paint.color;
+          final paints = _paintsFor(stroke);
+          final core = paints.base;
+          final edge = paints.edge;
           final nibAngleDeg =
               stroke.calligraphyNibAngleDeg ?? 40.0; // default if unset
           final nibAngle = nibAngleDeg * math.pi / 180.0;
           final nibDir = Offset(math.cos(nibAngle), math.sin(nibAngle));
+          final widthFactor =
+              (stroke.calligraphyNibWidthFactor ?? 1.0).clamp(0.3, 2.5);
           for (int i = 0; i < points.length - 1; i++) {
             final a = points[i];
             final b = points[i + 1];
@@ -723,29 +938,14 @@ class SketchPainter extends CustomPainter {
             // Thickness follows |sin(theta)| between stroke and nib direction
             final cross = (t.dx * nibDir.dy - t.dy * nibDir.dx).abs();
             final pressure = (a.pressure + b.pressure) * 0.5;
-            final widthFactor =
-                (stroke.calligraphyNibWidthFactor ?? 1.0).clamp(0.3, 2.5);
             final thickness = math.max(
               0.6,
               stroke.width * widthFactor * (0.35 + 0.9 * cross) * pressure,
             );
-            final core = Paint()
-              ..color = baseColor.withValues(alpha: stroke.opacity)
-              ..style = PaintingStyle.stroke
-              ..strokeCap = StrokeCap.butt
-              ..strokeJoin = StrokeJoin.round
-              ..isAntiAlias = true
-              ..strokeWidth = thickness;
+            core.strokeWidth = thickness;
             canvas.drawLine(a.offset, b.offset, core);
             // Soft edge pass to slightly feather the ribbon
-            final edge = Paint()
-              ..color = baseColor.withValues(alpha: stroke.opacity * 0.25)
-              ..style = PaintingStyle.stroke
-              ..strokeCap = StrokeCap.butt
-              ..strokeJoin = StrokeJoin.round
-              ..isAntiAlias = true
-              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.6)
-              ..strokeWidth = thickness * 1.1;
+            edge.strokeWidth = thickness * 1.1;
             canvas.drawLine(a.offset, b.offset, edge);
           }
         }
@@ -754,49 +954,75 @@ class SketchPainter extends CustomPainter {
         // Pastel: chalky, layered dabs with grain
         {
           final baseColor = paint.color;
-          final rnd = math.Random(2718);
-          for (final p in points) {
+          final paints = _paintsFor(stroke);
+          final smudge = paints.edge;
+          final body = paints.base;
+          final speck = paints.texture;
+          final grainDensity =
+              (stroke.pastelGrainDensity ?? 1.0).clamp(0.3, 3.0);
+          final grainShader = BrushTextures.shader(BrushTexture.pastelGrain);
+          if (grainShader != null) {
+            // Density scales the tile's strength instead of the speck count.
+            // The grain keeps to the smudge and is spaced like charcoal's.
+            final grain = paints.grain(grainShader,
+                alpha: stroke.opacity * 0.3 * grainDensity);
+            Offset? lastGrain;
+            for (final p in points) {
+              final w = (stroke.width * p.pressure).clamp(0.5, 220.0);
+              canvas.drawCircle(p.offset, w * 0.55, smudge);
+              canvas.drawCircle(p.offset, w * 0.42, body);
+              if (lastGrain == null ||
+                  (p.offset - lastGrain).distance >= w * 0.5) {
+                canvas.drawCircle(p.offset, w * 0.55, grain);
+                lastGrain = p.offset;
+              }
+            }
+            break;
+          }
+          for (int pi = 0; pi < points.length; pi++) {
+            final p = points[pi];
             final w = (stroke.width * p.pressure).clamp(0.5, 220.0);
             // Base smudge
-            final base = Paint()
-              ..color = baseColor.withValues(alpha: stroke.opacity * 0.35)
-              ..style = PaintingStyle.fill
-              ..isAntiAlias = true
-              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.8);
-            canvas.drawCircle(p.offset, w * 0.55, base);
+            canvas.drawCircle(p.offset, w * 0.55, smudge);
 
             // Chalk body
-            final body = Paint()
-              ..color = baseColor.withValues(alpha: stroke.opacity * 0.55)
-              ..style = PaintingStyle.fill
-              ..isAntiAlias = true;
             canvas.drawCircle(p.offset, w * 0.42, body);
 
             // Grain speckles around
-            final grainDensity =
-                (stroke.pastelGrainDensity ?? 1.0).clamp(0.3, 3.0);
             final grains = (w * 0.8 * grainDensity).round().clamp(4, 50);
             for (int i = 0; i < grains; i++) {
-              final ang = rnd.nextDouble() * 2 * math.pi;
-              final dist = rnd.nextDouble() * w * 0.6;
-              final gSize = 0.6 + rnd.nextDouble() * 1.4;
+              final k = i * 4;
+              final ang = StrokeNoise.unit(seed, pi, k) * 2 * math.pi;
+              final dist = StrokeNoise.unit(seed, pi, k + 1) * w * 0.6;
+              final gSize = 0.6 + StrokeNoise.unit(seed, pi, k + 2) * 1.4;
               final gOff = Offset(math.cos(ang) * dist, math.sin(ang) * dist);
-              final alpha = stroke.opacity * (0.06 + rnd.nextDouble() * 0.24);
-              final speck = Paint()
-                ..color = baseColor.withValues(alpha: alpha)
-                ..style = PaintingStyle.fill
-                ..isAntiAlias = true;
+              final alpha = stroke.opacity *
+                  (0.06 + StrokeNoise.unit(seed, pi, k + 3) * 0.24);
+              speck.color = baseColor.withValues(alpha: alpha);
               canvas.drawCircle(p.offset + gOff, gSize, speck);
             }
           }
         }
         break;
     }
+    if (kSketchTrace) PerfTrace.end();
   }
 
   // Insert intermediate points along segments longer than maxSegmentLen (pixels)
   List<DrawingPoint> _interpolatePoints(List<DrawingPoint> pts,
       {double maxSegmentLen = 4.0}) {
+    if (!kSketchTrace) return _interpolate(pts, maxSegmentLen);
+    PerfTrace.begin('SketchPainter._interpolatePoints', <String, Object?>{
+      'points': pts.length,
+      'maxSegmentLen': maxSegmentLen,
+    });
+    final out = _interpolate(pts, maxSegmentLen);
+    PerfTrace.end();
+    return out;
+  }
+
+  List<DrawingPoint> _interpolate(
+      List<DrawingPoint> pts, double maxSegmentLen) {
     if (pts.length < 2) return pts;
     final out = <DrawingPoint>[];
     out.add(pts.first);
@@ -846,6 +1072,15 @@ class SketchPainter extends CustomPainter {
   // Catmull–Rom to Bezier conversion for smoother curves
   Path _createCatmullRomPath(List<DrawingPoint> points,
       {bool closed = false, double alpha = 0.5}) {
+    if (!kSketchTrace) return _catmullRom(points, closed, alpha);
+    PerfTrace.begin('SketchPainter._createCatmullRomPath',
+        <String, Object?>{'points': points.length});
+    final path = _catmullRom(points, closed, alpha);
+    PerfTrace.end();
+    return path;
+  }
+
+  Path _catmullRom(List<DrawingPoint> points, bool closed, double alpha) {
     final path = Path();
     if (points.length < 2) {
       if (points.isNotEmpty) {
@@ -931,7 +1166,9 @@ class SketchPainter extends CustomPainter {
     Rect bounds;
     if (_boundsCache.containsKey(stroke)) {
       bounds = _boundsCache[stroke]!;
+      stats.boundsCacheHits++;
     } else {
+      stats.boundsCacheMisses++;
       bounds = _getBoundingRect(stroke.points);
       _cacheStrokeBounds(stroke, bounds);
     }
@@ -955,7 +1192,7 @@ class SketchPainter extends CustomPainter {
   @override
   bool shouldRepaint(covariant CustomPainter oldDelegate) {
     if (oldDelegate is! SketchPainter) {
-      print('🎨 REPAINT: Different painter type - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'different painter type');
       return true;
     }
 
@@ -964,46 +1201,107 @@ class SketchPainter extends CustomPainter {
     // Fast checks first - most common cases
     // Repaint when current stroke changes (for live drawing)
     if (!identical(old.currentStroke, currentStroke)) {
-      print('🎨 REPAINT: Current stroke changed - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'current stroke changed');
       return true;
     }
 
     // Repaint when stroke count changes (especially for undo)
     if (old.strokes.length != strokes.length) {
-      print(
-          '🎨 REPAINT: Stroke count changed ${old.strokes.length} -> ${strokes.length} - repaint TRUE');
+      if (kSketchLog) {
+        SketchLog.log('repaint', 'stroke count changed', <String, Object?>{
+          'from': old.strokes.length,
+          'to': strokes.length,
+        });
+      }
       return true;
     }
 
     // Efficient reference check - if list reference changed, we need to repaint
     // This avoids expensive per-stroke comparisons
     if (!identical(old.strokes, strokes)) {
-      print('🎨 REPAINT: Strokes list reference changed - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'strokes list replaced');
       return true;
     }
 
     // Background property checks
     if (old.backgroundImage != backgroundImage) {
-      print('🎨 REPAINT: Background image changed - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'background image changed');
       return true;
     }
     if (old.imageOpacity != imageOpacity) {
-      print('🎨 REPAINT: Image opacity changed - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'image opacity changed');
       return true;
     }
     if (old.isImageVisible != isImageVisible) {
-      print('🎨 REPAINT: Image visibility changed - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'image visibility changed');
       return true;
     }
 
     // Repaint when anchored image rect changes
     if (old.anchoredImageRect != anchoredImageRect) {
-      print('🎨 REPAINT: Anchored image rect changed - repaint TRUE');
+      if (kSketchLog) SketchLog.log('repaint', 'anchored image rect changed');
+      return true;
+    }
+
+    if (old.optimized != optimized) {
+      if (kSketchLog) SketchLog.log('repaint', 'rendering path changed');
+      return true;
+    }
+
+    // Layers are replaced, never mutated, when anything about them changes
+    if (old.activeLayer != activeLayer ||
+        old.layers.length != layers.length) {
+      if (kSketchLog) SketchLog.log('repaint', 'layers changed');
       return true;
     }
+    for (int i = 0; i < layers.length; i++) {
+      if (!identical(old.layers[i], layers[i])) {
+        if (kSketchLog) SketchLog.log('repaint', 'layer changed');
+        return true;
+      }
+    }
 
     // If we reach here, no changes detected
-    print('🎨 REPAINT: No changes detected - repaint FALSE');
+    if (kSketchLog) SketchLog.log('repaint', 'skipped, no changes');
     return false;
   }
 }
+
+/// A recorded inactive layer and what it was recorded from.
+class _LayerPicture {
+  final ui.Picture picture;
+  final int revision;
+  final Size size;
+
+  const _LayerPicture(this.picture, this.revision, this.size);
+}
+
+/// A run of consecutive batchable pen strokes, drawn as one path.
+class _PenBatch {
+  Stroke? _first;
+  Path? _path;
+  int drawCalls = 0;
+
+  bool accepts(Stroke stroke) =>
+      _first == null || SketchPainter.canBatchTogether(_first!, stroke);
+
+  void add(Stroke stroke, Path path) {
+    if (_path == null) {
+      _first = stroke;
+      _path = path;
+    } else {
+      _path!.addPath(path, Offset.zero);
+    }
+  }
+
+  void flush(Canvas canvas, StrokePaints Function(Stroke) paintsFor) {
+    final first = _first;
+    final path = _path;
+    if (first == null || path == null) return;
+    final paint = paintsFor(first).base..strokeWidth = first.width;
+    canvas.drawPath(path, paint);
+    drawCalls++;
+    _first = null;
+    _path = null;
+  }
+}
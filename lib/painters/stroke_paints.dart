@@ -0,0 +1,194 @@
+import 'package:flutter/material.dart';
+import 'dart:math' as math;
+import '../models/stroke.dart';
+import '../models/drawing_tool.dart';
+import '../models/brush_mode.dart';
+
+/// Reusable paint state for one stroke.
+///
+/// Built once from the stroke's color, opacity and blend mode so the
+/// per-segment and per-dab loops in `SketchPainter` only adjust width or
+/// alpha on an existing [Paint] instead of allocating and configuring one.
+/// Which role each paint plays depends on the tool / brush mode:
+///
+/// * [base]    main body (pencil line, charcoal dab, oil body, nib core, ...)
+/// * [texture] grain, specks, particles and daubs
+/// * [edge]    soft feather or underpaint pass
+/// * [glow]    wide blurred halo, bleed or highlight
+class StrokePaints {
+  final Paint base;
+  final Paint texture;
+  final Paint edge;
+  final Paint glow;
+
+  /// Pencil texture color, resolved once (luminance is not cheap)
+  final Color textureColor;
+
+  Paint? _grain;
+
+  StrokePaints._({
+    required this.base,
+    required this.texture,
+    required this.edge,
+    required this.glow,
+    required this.textureColor,
+  });
+
+  factory StrokePaints.forStroke(Stroke stroke) {
+    final color = stroke.color.withValues(alpha: stroke.opacity);
+    final opacity = stroke.opacity;
+
+    Paint stroked() => Paint()
+      ..style = PaintingStyle.stroke
+      ..strokeCap = StrokeCap.round
+      ..strokeJoin = StrokeJoin.round
+      ..isAntiAlias = true;
+    Paint filled() => Paint()
+      ..style = PaintingStyle.fill
+      ..isAntiAlias = true;
+
+    Color textureColor = color;
+    Paint base;
+    Paint texture;
+    Paint edge;
+    Paint glow;
+
+    switch (stroke.tool) {
+      case DrawingTool.pencil:
+        final isBright = color.computeLuminance() > 0.7;
+        textureColor = isBright
+            ? Colors.black.withValues(alpha: 0.12)
+            : color.withValues(alpha: (color.a * 0.18).clamp(0.05, 0.2));
+        base = stroked()
+          ..color = color
+          ..blendMode = BlendMode.srcOver
+          ..filterQuality = FilterQuality.high;
+        texture = stroked()
+          ..color = textureColor
+          ..blendMode = BlendMode.srcOver
+          ..filterQuality = FilterQuality.high;
+        edge = base;
+        glow = base;
+        break;
+      case DrawingTool.eraser:
+        base = stroked()
+          ..strokeWidth = stroke.width
+          ..blendMode = BlendMode.dstOut
+          ..color = Colors.black.withValues(alpha: 0.95);
+        edge = stroked()
+          ..strokeWidth = stroke.width * 1.5
+          ..blendMode = BlendMode.dstOut
+          ..color = Colors.black.withValues(alpha: 0.35);
+        texture = base;
+        glow = edge;
+        break;
+      case DrawingTool.brush:
+        switch (stroke.brushMode) {
+          case BrushMode.charcoal:
+            base = filled()..color = color.withValues(alpha: opacity * 0.7);
+            texture = filled();
+            edge = base;
+            glow = base;
+            break;
+          case BrushMode.watercolor:
+            base = stroked()
+              ..color = color.withValues(alpha: opacity * 0.35)
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 1.0)
+              ..strokeWidth = stroke.width * 0.9;
+            edge = stroked()
+              ..color = color.withValues(alpha: opacity * 0.22)
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 2.5)
+              ..strokeWidth = stroke.width * 1.2;
+            glow = filled()
+              ..color = color.withValues(alpha: opacity * 0.12)
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 2.0);
+            texture = glow;
+            break;
+          case BrushMode.oilPaint:
+            edge = stroked()
+              ..color =
+                  color.withValues(alpha: (opacity * 0.22).clamp(0.0, 1.0))
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 1.5)
+              ..strokeWidth = stroke.width * 1.35;
+            base = stroked()
+              ..color = color.withValues(alpha: opacity.clamp(0.0, 1.0))
+              ..strokeWidth = stroke.width;
+            glow = stroked()
+              ..color = Colors.white.withValues(alpha: opacity * 0.18)
+              ..strokeWidth = math.max(1.0, stroke.width * 0.35)
+              ..blendMode = BlendMode.screen;
+            texture = Paint()
+              ..color = color.withValues(alpha: opacity * 0.35)
+              ..style = PaintingStyle.fill;
+            break;
+          case BrushMode.airbrush:
+            base = stroked()
+              ..color = color.withValues(alpha: opacity * 0.15)
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.5);
+            texture = filled()
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.8);
+            edge = base;
+            glow = texture;
+            break;
+          case BrushMode.calligraphy:
+            base = stroked()
+              ..color = color.withValues(alpha: opacity)
+              ..strokeCap = StrokeCap.butt;
+            edge = stroked()
+              ..color = color.withValues(alpha: opacity * 0.25)
+              ..strokeCap = StrokeCap.butt
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.6);
+            texture = base;
+            glow = edge;
+            break;
+          case BrushMode.pastel:
+            edge = filled()
+              ..color = color.withValues(alpha: opacity * 0.35)
+              ..maskFilter = const MaskFilter.blur(BlurStyle.normal, 0.8);
+            base = filled()..color = color.withValues(alpha: opacity * 0.55);
+            texture = filled();
+            glow = edge;
+            break;
+          case null:
+            base = stroked()..color = color;
+            texture = base;
+            edge = base;
+            glow = base;
+            break;
+        }
+        break;
+      case DrawingTool.pen:
+      case DrawingTool.marker:
+        base = stroked()
+          ..color = color
+          ..blendMode = stroke.blendMode;
+        texture = base;
+        edge = base;
+        glow = base;
+        break;
+    }
+
+    return StrokePaints._(
+      base: base,
+      texture: texture,
+      edge: edge,
+      glow: glow,
+      textureColor: textureColor,
+    );
+  }
+
+  /// Grain from a `BrushTextures` [shader], tinted with [textureColor] and
+  /// scaled by [alpha]. Built on first use; every call sets the shader,
+  /// alpha and style it asks for.
+  Paint grain(ImageShader shader,
+      {required double alpha, PaintingStyle style = PaintingStyle.fill}) {
+    return (_grain ??= Paint()
+      ..strokeCap = StrokeCap.round
+      ..isAntiAlias = true
+      ..colorFilter = ColorFilter.mode(
+          textureColor.withValues(alpha: 1.0), BlendMode.srcIn))
+      ..style = style
+      ..shader = shader
+      ..color = Colors.black.withValues(alpha: alpha.clamp(0.0, 1.0));
+  }
+}
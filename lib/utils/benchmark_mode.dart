@@ -0,0 +1,136 @@
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
+import 'package:flutter/services.dart';
+import 'package:get/get.dart';
+import '../controllers/sketch_controller.dart';
+import '../models/input_session.dart';
+import 'frame_stats.dart';
+import 'input_replayer.dart';
+
+/// Command line options for a benchmark run.
+///
+/// `--benchmark=<session>` replays a recorded input session, then writes
+/// frame statistics to `--benchmark-out=<json>` (default
+/// `benchmark-results.json`) and exits. `--benchmark-speed=recorded` keeps the
+/// recorded timing instead of replaying one event per frame.
+class BenchmarkOptions {
+  final String sessionPath;
+  final String outPath;
+  final ReplaySpeed speed;
+  final Duration timeout;
+
+  const BenchmarkOptions({
+    required this.sessionPath,
+    this.outPath = 'benchmark-results.json',
+    this.speed = ReplaySpeed.max,
+    this.timeout = const Duration(minutes: 10),
+  });
+
+  static BenchmarkOptions? fromArgs(List<String> args) {
+    String? session;
+    String? out;
+    var speed = ReplaySpeed.max;
+    for (final arg in args) {
+      if (arg.startsWith('--benchmark=')) {
+        session = arg.substring('--benchmark='.length);
+      } else if (arg.startsWith('--benchmark-out=')) {
+        out = arg.substring('--benchmark-out='.length);
+      } else if (arg == '--benchmark-speed=recorded') {
+        speed = ReplaySpeed.recorded;
+      }
+    }
+    if (session == null || session.isEmpty) return null;
+    return BenchmarkOptions(
+      sessionPath: session,
+      outPath: out == null || out.isEmpty ? 'benchmark-results.json' : out,
+      speed: speed,
+    );
+  }
+}
+
+const MethodChannel _benchmarkChannel = MethodChannel('sketcher/benchmark');
+
+/// Replays the session in a full app built by [appFor], writes the report
+/// and tells the runner the exit status (0 = ok, 1 = failed).
+Future<void> runBenchmark(
+  BenchmarkOptions options,
+  Widget Function(CanvasReplay replay) appFor,
+) async {
+  var status = 0;
+  final timings = <FrameTiming>[];
+  void onTimings(List<FrameTiming> batch) => timings.addAll(batch);
+
+  try {
+    final session = InputSession.fromBytes(
+        await File(options.sessionPath).readAsBytes());
+    final replay = CanvasReplay(session, speed: options.speed);
+
+    SchedulerBinding.instance.addTimingsCallback(onTimings);
+    final wall = Stopwatch()..start();
+    runApp(appFor(replay));
+    await replay.done.timeout(options.timeout);
+    wall.stop();
+
+    // Frame timings are reported in batches; let the last ones arrive
+    await SchedulerBinding.instance.endOfFrame;
+    await Future<void>.delayed(const Duration(milliseconds: 250));
+    SchedulerBinding.instance.removeTimingsCallback(onTimings);
+
+    final report = _report(options, session, timings, wall.elapsed);
+    await File(options.outPath)
+        .writeAsString(const JsonEncoder.withIndent('  ').convert(report));
+    debugPrint('Benchmark: ${timings.length} frames -> ${options.outPath}');
+  } catch (e) {
+    debugPrint('Benchmark failed: $e');
+    SchedulerBinding.instance.removeTimingsCallback(onTimings);
+    status = 1;
+  }
+
+  try {
+    await _benchmarkChannel.invokeMethod<void>('finished', status);
+  } on MissingPluginException {
+    // Runners without the benchmark channel: exit directly.
+    exit(status);
+  }
+}
+
+Map<String, Object?> _report(
+  BenchmarkOptions options,
+  InputSession session,
+  List<FrameTiming> timings,
+  Duration wall,
+) {
+  final stats =
+      RollingFrameStats(capacity: timings.isEmpty ? 1 : timings.length);
+  int overBudget = 0;
+  for (final timing in timings) {
+    stats.addTiming(timing);
+    if (timing.totalSpan.inMicroseconds > 16667) overBudget++;
+  }
+  Map<String, double> percentiles(double Function(double) at) => {
+        'p50': at(50),
+        'p90': at(90),
+        'p99': at(99),
+        'max': at(100),
+      };
+
+  return <String, Object?>{
+    'session': options.sessionPath,
+    'speed': options.speed.name,
+    'events': session.events.length,
+    'recordedStrokes': session.strokeCount,
+    'recordedDurationMs': session.duration.inMicroseconds / 1000.0,
+    'wallMs': wall.inMicroseconds / 1000.0,
+    'frames': timings.length,
+    'framesOverBudget': overBudget,
+    'buildMs': percentiles(stats.buildMs),
+    'rasterMs': percentiles(stats.rasterMs),
+    'strokes': Get.isRegistered<SketchController>()
+        ? Get.find<SketchController>().strokes.length
+        : null,
+    'maxRssBytes': ProcessInfo.maxRss,
+  };
+}
@@ -0,0 +1,140 @@
+import 'dart:async';
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+import 'package:flutter/painting.dart';
+import 'brush_textures_stub.dart'
+    if (dart.library.ffi) 'brush_textures_native.dart';
+import 'image_tracker.dart';
+import 'stroke_noise.dart';
+
+/// Precomputed grain tiles; the index is the id used by the Linux runner.
+enum BrushTexture {
+  /// Fine paper tooth under pencil lines.
+  pencilPaper,
+
+  /// Coarse, specky grain for charcoal dabs.
+  charcoalGrain,
+
+  /// Soft chalk grain for pastel dabs.
+  pastelGrain,
+}
+
+class _TextureSpec {
+  final int seed;
+  final List<int> periods;
+  final List<int> weights;
+  final int bias;
+  final int gain;
+  final int speckThreshold;
+  final int speckBoost;
+
+  const _TextureSpec(this.seed, this.periods, this.weights, this.bias,
+      this.gain, this.speckThreshold, this.speckBoost);
+}
+
+/// Grain textures for the pencil, charcoal and pastel brushes.
+///
+/// Each tile is [edge]×[edge] alpha bytes and tiles seamlessly. The Linux
+/// runner compiles them into its binary as a GResource
+/// (`linux/runner/resources/brush_textures/*.r8`), and [tile] returns a
+/// read-only view straight into that mapped data through FFI. Elsewhere the
+/// same bytes are synthesized by [synthesize], which also generates the
+/// checked-in files (see `test/utils/brush_textures_test.dart`).
+///
+/// Painters ask for a [shader] and fall back to procedural `StrokeNoise`
+/// specks until [load] has uploaded the tiles, once, off the startup path.
+class BrushTextures {
+  BrushTextures._();
+
+  static const int edge = 128;
+
+  // Integer-only value noise so every port yields identical bytes
+  static const Map<BrushTexture, _TextureSpec> _specs = {
+    BrushTexture.pencilPaper:
+        _TextureSpec(0x50454E43, [32, 64], [1, 2], 112, 3, 256, 0),
+    BrushTexture.charcoalGrain:
+        _TextureSpec(0x43484152, [8, 16, 32], [2, 2, 1], 104, 3, 232, 72),
+    BrushTexture.pastelGrain:
+        _TextureSpec(0x50415354, [16, 32, 64], [1, 2, 2], 96, 2, 240, 48),
+  };
+
+  static final Map<BrushTexture, ImageShader> _shaders = {};
+  static Future<void>? _loading;
+
+  /// The tile's alpha bytes, row-major; do not modify.
+  static Uint8List tile(BrushTexture texture) =>
+      nativeBrushTexture(texture.index, edge) ?? synthesize(texture);
+
+  /// Repeating shader for [texture], anchored to canvas space like paper;
+  /// null until [load] completes.
+  static ImageShader? shader(BrushTexture texture) => _shaders[texture];
+
+  /// Uploads every tile as an image. Safe to call more than once.
+  static Future<void> load() => _loading ??= _load();
+
+  static Future<void> _load() async {
+    final identity = Float64List(16)
+      ..[0] = 1.0
+      ..[5] = 1.0
+      ..[10] = 1.0
+      ..[15] = 1.0;
+    for (final texture in BrushTexture.values) {
+      final alpha = tile(texture);
+      // The GPU upload needs RGBA: white, with the grain as alpha
+      final rgba = Uint8List(alpha.length * 4);
+      for (int i = 0, j = 0; i < alpha.length; i++, j += 4) {
+        rgba[j] = 255;
+        rgba[j + 1] = 255;
+        rgba[j + 2] = 255;
+        rgba[j + 3] = alpha[i];
+      }
+      final completer = Completer<ui.Image>();
+      ui.decodeImageFromPixels(
+          rgba, edge, edge, ui.PixelFormat.rgba8888, completer.complete);
+      final image = ImageTracker.image(
+          await completer.future, 'BrushTextures.load',
+          permanent: true);
+      _shaders[texture] =
+          ImageShader(image, TileMode.repeated, TileMode.repeated, identity);
+    }
+  }
+
+  /// Generates [texture] from integer value noise over [StrokeNoise.hash].
+  static Uint8List synthesize(BrushTexture texture) {
+    final spec = _specs[texture]!;
+    final out = Uint8List(edge * edge);
+    final weightSum = spec.weights.fold<int>(0, (a, b) => a + b);
+    for (int y = 0; y < edge; y++) {
+      for (int x = 0; x < edge; x++) {
+        int n = 0;
+        for (int o = 0; o < spec.periods.length; o++) {
+          n += spec.weights[o] * _octave(spec.seed, spec.periods[o], o, x, y);
+        }
+        n ~/= weightSum;
+        final speck = StrokeNoise.hash(spec.seed, x + y * edge, 64) >>> 24;
+        final boost = speck >= spec.speckThreshold ? spec.speckBoost : 0;
+        out[y * edge + x] = ((n - spec.bias) * spec.gain + boost).clamp(0, 255);
+      }
+    }
+    return out;
+  }
+
+  // Bilinear value noise on a period×period lattice that wraps at the edge
+  static int _octave(int seed, int period, int octave, int x, int y) {
+    final cell = edge ~/ period;
+    final ix = x ~/ cell;
+    final iy = y ~/ cell;
+    final fx = x % cell;
+    final fy = y % cell;
+    int lattice(int lx, int ly) {
+      final index = (lx % period) + (ly % period) * period;
+      return StrokeNoise.hash(seed, index, octave) >>> 24;
+    }
+
+    return (lattice(ix, iy) * (cell - fx) * (cell - fy) +
+            lattice(ix + 1, iy) * fx * (cell - fy) +
+            lattice(ix, iy + 1) * (cell - fx) * fy +
+            lattice(ix + 1, iy + 1) * fx * fy) ~/
+        (cell * cell);
+  }
+}
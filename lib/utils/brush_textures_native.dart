@@ -0,0 +1,37 @@
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:typed_data';
+
+typedef _TextureDataC = Pointer<Uint8> Function(Int32 id);
+typedef _TextureData = Pointer<Uint8> Function(int id);
+typedef _TextureEdgeC = Int32 Function(Int32 id);
+typedef _TextureEdge = int Function(int id);
+
+/// Exported by the Linux runner (`linux/runner/brush_textures.cc`); absent
+/// from other runners and `flutter test`.
+final ({_TextureData data, _TextureEdge edge})? _runner = _bind();
+
+({_TextureData data, _TextureEdge edge})? _bind() {
+  if (!Platform.isLinux) return null;
+  try {
+    final lib = DynamicLibrary.executable();
+    return (
+      data: lib.lookupFunction<_TextureDataC, _TextureData>(
+          'sketcher_brush_texture_data'),
+      edge: lib.lookupFunction<_TextureEdgeC, _TextureEdge>(
+          'sketcher_brush_texture_edge'),
+    );
+  } on ArgumentError {
+    return null;
+  }
+}
+
+/// A view of texture [id] inside the runner's mapped binary: no decode and
+/// no copy. Null unless the runner provides an [edge]×[edge] tile.
+Uint8List? nativeBrushTexture(int id, int edge) {
+  final runner = _runner;
+  if (runner == null || runner.edge(id) != edge) return null;
+  final data = runner.data(id);
+  if (data == nullptr) return null;
+  return data.asTypedList(edge * edge);
+}
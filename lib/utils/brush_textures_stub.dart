@@ -0,0 +1,4 @@
+import 'dart:typed_data';
+
+/// No FFI on this platform: textures are always synthesized.
+Uint8List? nativeBrushTexture(int id, int edge) => null;
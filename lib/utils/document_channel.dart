@@ -0,0 +1,100 @@
+import 'dart:convert';
+import 'dart:io';
+import 'package:flutter/material.dart';
+import 'package:flutter/services.dart';
+import 'package:get/get.dart';
+import '../controllers/sketch_controller.dart';
+import '../models/sketch_document.dart';
+
+/// Opens documents handed over by the Linux runner.
+///
+/// With `--single-instance`, opening a file in a second process forwards the
+/// path to the running one over `sketcher/documents`, so the document opens
+/// in the warm isolate instead of paying a cold start. The runner holds paths
+/// until [attach] reports `ready`, so files passed at launch are not lost.
+///
+/// A document replaces the drawing on the canvas, so [open] asks first when
+/// there is one, and the replacement is an undo step.
+class DocumentChannel {
+  DocumentChannel._();
+
+  static const MethodChannel _channel = MethodChannel('sketcher/documents');
+
+  // Opens run one after another, so paths forwarded together each get
+  // their own prompt and undo step, in the order they arrived.
+  static Future<void> _queue = Future<void>.value();
+
+  static void attach(SketchController controller) {
+    _channel.setMethodCallHandler((call) async {
+      if (call.method != 'open') {
+        throw MissingPluginException('Unknown method ${call.method}');
+      }
+      return open(call.arguments as String, controller);
+    });
+    _ready();
+  }
+
+  static Future<void> _ready() async {
+    try {
+      await _channel.invokeMethod<void>('ready');
+    } on MissingPluginException {
+      // Not the Linux runner: nothing will be forwarded
+    }
+  }
+
+  /// Loads the document at [path] in place of the drawing on the canvas,
+  /// once [confirm] allows it; an empty canvas is replaced without asking.
+  /// Returns false if the open was declined, or if the document cannot be
+  /// read, in which case an error is shown.
+  static Future<bool> open(String path, SketchController controller,
+      {Future<bool> Function(String path) confirm = _confirmReplace}) {
+    final opened = _queue.then((_) => _open(path, controller, confirm));
+    _queue = opened.then<void>((_) {}, onError: (Object _) {});
+    return opened;
+  }
+
+  static Future<bool> _open(String path, SketchController controller,
+      Future<bool> Function(String path) confirm) async {
+    final SketchDocument document;
+    try {
+      final json = jsonDecode(await File(path).readAsString());
+      document = SketchDocument.fromJson(json as Map<String, dynamic>);
+    } catch (e) {
+      debugPrint('Failed to open document $path: $e');
+      Get.snackbar(
+        'Open Error',
+        'Failed to open $path: $e',
+        snackPosition: SnackPosition.BOTTOM,
+        backgroundColor: Colors.red,
+        colorText: Colors.white,
+      );
+      return false;
+    }
+    if (controller.allStrokes.isNotEmpty && !await confirm(path)) {
+      return false;
+    }
+    controller.loadDocument(document);
+    return true;
+  }
+
+  static Future<bool> _confirmReplace(String path) async {
+    final replace = await Get.dialog<bool>(
+      AlertDialog(
+        title: const Text('Open Document'),
+        content: Text('Opening $path replaces the drawing on the canvas. '
+            'Undo brings the drawing back.'),
+        actions: [
+          TextButton(
+            onPressed: () => Get.back(result: false),
+            child: const Text('Cancel'),
+          ),
+          ElevatedButton(
+            onPressed: () => Get.back(result: true),
+            child: const Text('Open'),
+          ),
+        ],
+      ),
+    );
+    return replace ?? false;
+  }
+}
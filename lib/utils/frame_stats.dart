@@ -0,0 +1,56 @@
+import 'dart:typed_data';
+import 'dart:ui' show FrameTiming;
+
+/// Rolling window of frame build / raster times with percentile readouts.
+///
+/// Fixed-size ring buffers, so feeding it from `addTimingsCallback` costs no
+/// allocation per frame. Percentiles use the nearest-rank method.
+class RollingFrameStats {
+  RollingFrameStats({this.capacity = 240})
+      : _build = Float64List(capacity),
+        _raster = Float64List(capacity),
+        _scratch = Float64List(capacity);
+
+  final int capacity;
+  final Float64List _build; // microseconds
+  final Float64List _raster; // microseconds
+  final Float64List _scratch;
+  int _next = 0;
+  int _count = 0;
+
+  int get sampleCount => _count;
+
+  void addTiming(FrameTiming timing) {
+    addSample(
+      timing.buildDuration.inMicroseconds.toDouble(),
+      timing.rasterDuration.inMicroseconds.toDouble(),
+    );
+  }
+
+  void addSample(double buildMicros, double rasterMicros) {
+    _build[_next] = buildMicros;
+    _raster[_next] = rasterMicros;
+    _next = (_next + 1) % capacity;
+    if (_count < capacity) _count++;
+  }
+
+  /// Build time percentile in milliseconds; [p] is in `0..100`.
+  double buildMs(double p) => _percentile(_build, p) / 1000.0;
+
+  /// Raster time percentile in milliseconds; [p] is in `0..100`.
+  double rasterMs(double p) => _percentile(_raster, p) / 1000.0;
+
+  void clear() {
+    _next = 0;
+    _count = 0;
+  }
+
+  double _percentile(Float64List samples, double p) {
+    if (_count == 0) return 0.0;
+    final view = Float64List.sublistView(_scratch, 0, _count);
+    view.setRange(0, _count, samples);
+    view.sort();
+    final rank = ((p.clamp(0.0, 100.0) / 100.0) * _count).ceil();
+    return view[(rank - 1).clamp(0, _count - 1)];
+  }
+}
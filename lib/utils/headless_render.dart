@@ -0,0 +1,163 @@
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter/services.dart';
+import 'package:path/path.dart' as p;
+import '../models/sketch_document.dart';
+import '../painters/sketch_painter.dart';
+import 'brush_textures.dart';
+import 'image_tracker.dart';
+
+/// Options for `--headless-render`, passed in by the headless Linux runner.
+///
+/// Every `*.json` document in [inputDir] whose sorted index satisfies
+/// `index % shardCount == shardIndex` is rendered to `<name>.png` in
+/// [outputDir]. With [thumbnail] set, the longest edge is scaled down to
+/// that many pixels.
+class HeadlessRenderOptions {
+  final String inputDir;
+  final String outputDir;
+  final int? thumbnail;
+  final int shardIndex;
+  final int shardCount;
+
+  const HeadlessRenderOptions({
+    required this.inputDir,
+    required this.outputDir,
+    this.thumbnail,
+    this.shardIndex = 0,
+    this.shardCount = 1,
+  });
+
+  static HeadlessRenderOptions? fromArgs(List<String> args) {
+    if (!args.contains('--headless-render')) return null;
+    String? input;
+    String? output;
+    int? thumbnail;
+    var shardIndex = 0;
+    var shardCount = 1;
+    for (final arg in args) {
+      if (arg.startsWith('--input=')) {
+        input = arg.substring('--input='.length);
+      } else if (arg.startsWith('--output=')) {
+        output = arg.substring('--output='.length);
+      } else if (arg.startsWith('--thumbnail=')) {
+        thumbnail = int.tryParse(arg.substring('--thumbnail='.length));
+      } else if (arg.startsWith('--shard=')) {
+        final parts = arg.substring('--shard='.length).split('/');
+        if (parts.length == 2) {
+          shardIndex = int.tryParse(parts[0]) ?? 0;
+          shardCount = int.tryParse(parts[1]) ?? 1;
+        }
+      }
+    }
+    if (input == null || input.isEmpty) return null;
+    if (shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount) {
+      return null;
+    }
+    return HeadlessRenderOptions(
+      inputDir: input,
+      outputDir: output == null || output.isEmpty ? input : output,
+      thumbnail: thumbnail != null && thumbnail > 0 ? thumbnail : null,
+      shardIndex: shardIndex,
+      shardCount: shardCount,
+    );
+  }
+}
+
+/// Renders [document] to PNG bytes with the same [SketchPainter] as the app.
+///
+/// The background stays transparent, as in the canvas export.
+Future<Uint8List> renderDocumentPng(SketchDocument document,
+    {int? maxEdge}) async {
+  final size = document.canvasSize;
+  final longest = math.max(size.width, size.height);
+  final scale =
+      maxEdge == null || longest <= 0 ? 1.0 : math.min(1.0, maxEdge / longest);
+  final width = math.max(1, (size.width * scale).ceil());
+  final height = math.max(1, (size.height * scale).ceil());
+
+  final recorder = ui.PictureRecorder();
+  final canvas = Canvas(recorder);
+  canvas.scale(scale);
+  SketchPainter(strokes: document.strokes, isImageVisible: false)
+      .paint(canvas, size);
+  final picture =
+      ImageTracker.picture(recorder.endRecording(), 'renderDocumentPng');
+  final ui.Image image;
+  try {
+    image = ImageTracker.image(
+        await picture.toImage(width, height), 'renderDocumentPng');
+  } finally {
+    picture.dispose();
+  }
+  try {
+    final bytes = await image.toByteData(format: ui.ImageByteFormat.png);
+    if (bytes == null) throw StateError('PNG encoding failed');
+    return bytes.buffer.asUint8List();
+  } finally {
+    image.dispose();
+  }
+}
+
+const MethodChannel _headlessChannel = MethodChannel('sketcher/headless');
+
+/// Renders this shard's documents, then reports to the runner: status 0 if
+/// every document rendered, 1 otherwise.
+Future<void> runHeadlessRender(HeadlessRenderOptions options) async {
+  var rendered = 0;
+  var failed = 0;
+  try {
+    // The runner gives up on an engine that never gets this far
+    await _headlessChannel.invokeMethod<void>('started');
+  } on MissingPluginException {
+    // Not under the headless runner: nothing is waiting
+  }
+  try {
+    // Same grain as the app once its textures are up
+    await BrushTextures.load();
+    final files = Directory(options.inputDir)
+        .listSync()
+        .whereType<File>()
+        .where((f) => f.path.endsWith('.json'))
+        .toList()
+      ..sort((a, b) => a.path.compareTo(b.path));
+    await Directory(options.outputDir).create(recursive: true);
+
+    for (int i = 0; i < files.length; i++) {
+      if (i % options.shardCount != options.shardIndex) continue;
+      final file = files[i];
+      try {
+        final json = jsonDecode(await file.readAsString());
+        final document =
+            SketchDocument.fromJson(json as Map<String, dynamic>);
+        final png =
+            await renderDocumentPng(document, maxEdge: options.thumbnail);
+        final name = '${p.basenameWithoutExtension(file.path)}.png';
+        await File(p.join(options.outputDir, name)).writeAsBytes(png);
+        rendered++;
+      } catch (e) {
+        debugPrint('Headless render failed for ${file.path}: $e');
+        failed++;
+      }
+      // Painter caches are keyed by stroke; nothing carries over
+      SketchPainter.clearStrokeCache();
+      SketchPainter.clearBoundsCache();
+    }
+  } catch (e) {
+    debugPrint('Headless render failed: $e');
+    failed++;
+  }
+
+  debugPrint('Headless render shard ${options.shardIndex}/'
+      '${options.shardCount}: $rendered rendered, $failed failed');
+  final status = failed == 0 ? 0 : 1;
+  try {
+    await _headlessChannel.invokeMethod<void>('finished', status);
+  } on MissingPluginException {
+    exit(status);
+  }
+}
@@ -0,0 +1,158 @@
+import 'dart:ui' as ui;
+import 'package:flutter/foundation.dart';
+
+/// One image or picture the app created and has not disposed yet.
+///
+/// The object itself is held weakly, so tracking never keeps it alive;
+/// [resource] is null once it has been garbage collected.
+class TrackedResource {
+  final WeakReference<Object> _resource;
+  final String site;
+  final int bytes;
+  final bool permanent;
+  final bool isImage;
+  final StackTrace? stack;
+
+  TrackedResource({
+    required Object resource,
+    required this.site,
+    required this.bytes,
+    required this.permanent,
+    this.stack,
+  })  : _resource = WeakReference<Object>(resource),
+        isImage = resource is ui.Image;
+
+  Object? get resource => _resource.target;
+
+  bool get isDisposed {
+    final resource = this.resource;
+    if (resource == null) return true;
+    if (resource is ui.Image) return resource.debugDisposed;
+    return (resource as ui.Picture).debugDisposed;
+  }
+
+  @override
+  String toString() {
+    final kind = isImage ? 'Image' : 'Picture';
+    final buffer = StringBuffer('$kind from $site, $bytes bytes');
+    if (stack != null) buffer.write('\n$stack');
+    return buffer.toString();
+  }
+}
+
+/// Debug-mode registry of every [ui.Image] and [ui.Picture] the app creates.
+///
+/// Creation sites pass new objects through [image] or [picture], which
+/// record the site and size and hand the object straight back. Disposal is
+/// read from `debugDisposed`, so objects may be disposed anywhere. The perf
+/// overlay shows the live counts and tests call [leaks] to turn a missing
+/// `dispose()` into a failure. Objects that are garbage collected without
+/// ever being seen disposed are counted in [collected]. In profile and
+/// release builds every call returns its argument and records nothing.
+class ImageTracker {
+  ImageTracker._();
+
+  static final Map<int, TrackedResource> _live = <int, TrackedResource>{};
+  static final Finalizer<int> _finalizer = Finalizer<int>(_onCollected);
+  static int _nextId = 0;
+
+  /// Objects garbage collected while still registered, by creation site.
+  /// Disposal is only checked when the registry is read or added to, so an
+  /// object disposed just before it was collected may be counted too.
+  static final Map<String, int> collected = <String, int>{};
+
+  /// Also keep each creation stack; slow, for chasing a specific leak.
+  static bool captureStacks = false;
+
+  /// Registers [image], created at [site]. Mark images meant to live as
+  /// long as the process [permanent] so [leaks] ignores them.
+  static ui.Image image(ui.Image image, String site,
+      {bool permanent = false}) {
+    if (kDebugMode) {
+      _register(image, site, image.width * image.height * 4, permanent);
+    }
+    return image;
+  }
+
+  /// Registers [picture], recorded at [site].
+  static ui.Picture picture(ui.Picture picture, String site) {
+    if (kDebugMode) {
+      _register(picture, site, picture.approximateBytesUsed, false);
+    }
+    return picture;
+  }
+
+  static void _register(
+      Object resource, String site, int bytes, bool permanent) {
+    _prune();
+    final id = _nextId++;
+    _live[id] = TrackedResource(
+      resource: resource,
+      site: site,
+      bytes: bytes,
+      permanent: permanent,
+      stack: captureStacks ? StackTrace.current : null,
+    );
+    _finalizer.attach(resource, id);
+  }
+
+  /// Drops disposed entries, and counts those collected undisposed whose
+  /// finalizer has not run yet.
+  static void _prune() {
+    _live.removeWhere((_, entry) {
+      if (entry.resource == null) {
+        _countCollected(entry);
+        return true;
+      }
+      return entry.isDisposed;
+    });
+  }
+
+  static void _onCollected(int id) {
+    final entry = _live.remove(id);
+    if (entry != null) _countCollected(entry);
+  }
+
+  static void _countCollected(TrackedResource entry) {
+    collected.update(entry.site, (count) => count + 1, ifAbsent: () => 1);
+  }
+
+  /// Number of registrations held, disposed ones included until the next
+  /// prune.
+  @visibleForTesting
+  static int get registered => _live.length;
+
+  /// Everything registered and not yet disposed.
+  static List<TrackedResource> get live {
+    if (!kDebugMode) return const [];
+    _prune();
+    return _live.values.toList();
+  }
+
+  static int get liveImages => live.where((e) => e.isImage).length;
+
+  static int get liveImageBytes => live
+      .where((e) => e.isImage)
+      .fold<int>(0, (total, e) => total + e.bytes);
+
+  static int get livePictures => live.where((e) => !e.isImage).length;
+
+  static int get livePictureBytes => live
+      .where((e) => !e.isImage)
+      .fold<int>(0, (total, e) => total + e.bytes);
+
+  /// Live, non-permanent resources, optionally only those from [site].
+  static List<TrackedResource> leaks({String? site}) => live
+      .where((e) => !e.permanent && (site == null || e.site == site))
+      .toList();
+
+  /// One line per leak, for test failure messages.
+  static String describeLeaks({String? site}) =>
+      leaks(site: site).map((e) => e.toString()).join('\n');
+
+  /// Forgets every registration without disposing anything.
+  static void reset() {
+    _live.clear();
+    collected.clear();
+  }
+}
@@ -0,0 +1,118 @@
+import 'dart:ui' show Offset, Size;
+import 'package:flutter/gestures.dart';
+import '../models/brush_mode.dart';
+import '../models/drawing_tool.dart';
+import '../models/eraser_mode.dart';
+import '../models/input_session.dart';
+
+/// Captures canvas input into an [InputSession].
+///
+/// `DrawingCanvas` forwards its `Listener` events, the controller's tool,
+/// brush, eraser, lasso and view changes, and the layer operations of its
+/// layers panel here while [isRecording] is set. Recording costs
+/// one small object per event; nothing is written until [stop].
+class InputRecorder {
+  final List<InputEvent> _events = <InputEvent>[];
+  final Stopwatch _clock = Stopwatch();
+  Size _canvasSize = Size.zero;
+
+  bool get isRecording => _clock.isRunning;
+
+  int get eventCount => _events.length;
+
+  void start(Size canvasSize) {
+    _events.clear();
+    _canvasSize = canvasSize;
+    _clock
+      ..reset()
+      ..start();
+  }
+
+  InputSession stop() {
+    _clock.stop();
+    final session = InputSession(
+      canvasSize: _canvasSize,
+      events: List<InputEvent>.unmodifiable(_events),
+    );
+    _events.clear();
+    return session;
+  }
+
+  void recordPointer(PointerEvent event, int pointerCount) {
+    if (!isRecording) return;
+    final InputEventType type;
+    if (event is PointerDownEvent) {
+      type = InputEventType.down;
+    } else if (event is PointerMoveEvent) {
+      type = InputEventType.move;
+    } else if (event is PointerUpEvent) {
+      type = InputEventType.up;
+    } else if (event is PointerCancelEvent) {
+      type = InputEventType.cancel;
+    } else {
+      return;
+    }
+    _events.add(InputEvent(
+      type: type,
+      timeMicros: _clock.elapsedMicroseconds,
+      pointer: event.pointer,
+      kind: event.kind,
+      pointerCount: pointerCount,
+      position: event.localPosition,
+      pressure: event.pressure,
+      orientation: event.orientation,
+    ));
+  }
+
+  void recordTool(DrawingTool tool) =>
+      _recordSetting(InputEventType.tool, tool.index.toDouble());
+
+  void recordBrushMode(BrushMode? mode) =>
+      _recordSetting(InputEventType.brushMode, (mode?.index ?? -1).toDouble());
+
+  void recordBrushSize(double size) =>
+      _recordSetting(InputEventType.brushSize, size);
+
+  void recordColor(int argb) =>
+      _recordSetting(InputEventType.color, argb.toDouble());
+
+  void recordOpacity(double opacity) =>
+      _recordSetting(InputEventType.opacity, opacity);
+
+  void recordEraserMode(EraserMode mode) =>
+      _recordSetting(InputEventType.eraserMode, mode.index.toDouble());
+
+  void recordLassoMode(bool enabled) =>
+      _recordSetting(InputEventType.lassoMode, enabled ? 1.0 : 0.0);
+
+  /// Records a layer operation of [type] on the layer at [index], with its
+  /// setting in [value] as described on [InputEvent].
+  void recordLayer(InputEventType type, {int index = 0, double value = 0.0}) {
+    if (!isRecording) return;
+    _events.add(InputEvent(
+      type: type,
+      timeMicros: _clock.elapsedMicroseconds,
+      layer: index,
+      value: value,
+    ));
+  }
+
+  void recordView(double scale, Offset translation) {
+    if (!isRecording) return;
+    _events.add(InputEvent(
+      type: InputEventType.view,
+      timeMicros: _clock.elapsedMicroseconds,
+      value: scale,
+      position: translation,
+    ));
+  }
+
+  void _recordSetting(InputEventType type, double value) {
+    if (!isRecording) return;
+    _events.add(InputEvent(
+      type: type,
+      timeMicros: _clock.elapsedMicroseconds,
+      value: value,
+    ));
+  }
+}
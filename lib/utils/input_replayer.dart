@@ -0,0 +1,186 @@
+import 'dart:async';
+import 'package:flutter/gestures.dart';
+import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
+import '../controllers/sketch_controller.dart';
+import '../models/brush_mode.dart';
+import '../models/drawing_tool.dart';
+import '../models/eraser_mode.dart';
+import '../models/input_session.dart';
+
+enum ReplaySpeed {
+  /// Events are fed with their recorded timing.
+  recorded,
+
+  /// No waits; one pointer event per frame, so every event is painted.
+  max,
+}
+
+/// A replay for `DrawingCanvas` to run once it has laid out.
+///
+/// Used by the benchmark mode, which starts the app with a session instead
+/// of waiting for input; [done] completes when the canvas has replayed it.
+class CanvasReplay {
+  CanvasReplay(this.session, {this.speed = ReplaySpeed.max});
+
+  final InputSession session;
+  final ReplaySpeed speed;
+  final Completer<void> _done = Completer<void>();
+
+  Future<void> get done => _done.future;
+
+  void complete([Object? error, StackTrace? stackTrace]) {
+    if (_done.isCompleted) return;
+    if (error != null) {
+      _done.completeError(error, stackTrace);
+    } else {
+      _done.complete();
+    }
+  }
+}
+
+/// Feeds an [InputSession] back into the canvas.
+///
+/// Pointer events are rebuilt as [PointerEvent]s and handed to [onPointer],
+/// which `DrawingCanvas` routes to the same handlers its `Listener` uses.
+/// Setting, view and layer changes go straight to the [controller].
+class InputReplayer {
+  InputReplayer({
+    required this.session,
+    required this.controller,
+    required this.onPointer,
+    this.speed = ReplaySpeed.recorded,
+    Future<void> Function()? nextFrame,
+  }) : _nextFrame = nextFrame ?? (() => SchedulerBinding.instance.endOfFrame);
+
+  final InputSession session;
+  final SketchController controller;
+  final void Function(PointerEvent event) onPointer;
+  final ReplaySpeed speed;
+  final Future<void> Function() _nextFrame;
+  bool _cancelled = false;
+
+  bool get isCancelled => _cancelled;
+
+  void cancel() {
+    _cancelled = true;
+  }
+
+  /// Completes once every event has been dispatched or [cancel] was called.
+  Future<void> run() async {
+    final clock = Stopwatch()..start();
+    for (final event in session.events) {
+      if (_cancelled) return;
+      if (speed == ReplaySpeed.recorded) {
+        final wait = event.timeMicros - clock.elapsedMicroseconds;
+        if (wait > 0) {
+          await Future<void>.delayed(Duration(microseconds: wait));
+          if (_cancelled) return;
+        }
+      }
+      dispatch(event);
+      if (speed == ReplaySpeed.max && event.isPointer) await _nextFrame();
+    }
+  }
+
+  void dispatch(InputEvent event) {
+    if (event.isPointer) {
+      onPointer(toPointerEvent(event));
+      return;
+    }
+    switch (event.type) {
+      case InputEventType.tool:
+        controller.setTool(DrawingTool.values[event.value.toInt()]);
+        break;
+      case InputEventType.brushMode:
+        final index = event.value.toInt();
+        controller.setBrushMode(index < 0 ? null : BrushMode.values[index]);
+        break;
+      case InputEventType.brushSize:
+        controller.setBrushSize(event.value);
+        break;
+      case InputEventType.color:
+        controller.setColor(Color(event.value.toInt()));
+        break;
+      case InputEventType.opacity:
+        controller.setOpacity(event.value);
+        break;
+      case InputEventType.view:
+        controller.transformationController.value =
+            Matrix4.diagonal3Values(event.value, event.value, 1.0)
+              ..setTranslationRaw(event.position.dx, event.position.dy, 0.0);
+        break;
+      case InputEventType.eraserMode:
+        controller.setEraserMode(EraserMode.values[event.value.toInt()]);
+        break;
+      case InputEventType.lassoMode:
+        controller.setLassoMode(event.value != 0);
+        break;
+      case InputEventType.addLayer:
+        controller.addLayer();
+        break;
+      case InputEventType.removeLayer:
+        controller.removeLayer(event.layer);
+        break;
+      case InputEventType.activeLayer:
+        controller.setActiveLayer(event.layer);
+        break;
+      case InputEventType.layerOpacity:
+        controller.setLayerOpacity(event.layer, event.value);
+        break;
+      case InputEventType.layerVisible:
+        controller.setLayerVisible(event.layer, event.value != 0);
+        break;
+      case InputEventType.layerBlendMode:
+        controller.setLayerBlendMode(
+            event.layer, BlendMode.values[event.value.toInt()]);
+        break;
+      case InputEventType.down:
+      case InputEventType.move:
+      case InputEventType.up:
+      case InputEventType.cancel:
+        break;
+    }
+  }
+
+  static PointerEvent toPointerEvent(InputEvent event) {
+    final timeStamp = Duration(microseconds: event.timeMicros);
+    switch (event.type) {
+      case InputEventType.down:
+        return PointerDownEvent(
+          timeStamp: timeStamp,
+          pointer: event.pointer,
+          kind: event.kind,
+          position: event.position,
+          pressure: event.pressure,
+          orientation: event.orientation,
+        );
+      case InputEventType.move:
+        return PointerMoveEvent(
+          timeStamp: timeStamp,
+          pointer: event.pointer,
+          kind: event.kind,
+          position: event.position,
+          pressure: event.pressure,
+          orientation: event.orientation,
+        );
+      case InputEventType.up:
+        return PointerUpEvent(
+          timeStamp: timeStamp,
+          pointer: event.pointer,
+          kind: event.kind,
+          position: event.position,
+          pressure: event.pressure,
+          orientation: event.orientation,
+        );
+      default:
+        return PointerCancelEvent(
+          timeStamp: timeStamp,
+          pointer: event.pointer,
+          kind: event.kind,
+          position: event.position,
+          orientation: event.orientation,
+        );
+    }
+  }
+}
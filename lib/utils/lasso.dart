@@ -0,0 +1,61 @@
+import 'dart:ui';
+import '../models/stroke.dart';
+import 'stroke_index.dart';
+
+/// Picks strokes with a freehand lasso.
+///
+/// A stroke is selected when at least half of its points fall inside the
+/// lasso, so a loop that clips the end of a neighbouring stroke does not
+/// take it along. Strokes whose bounds miss the lasso's bounds are skipped
+/// before any point is tested.
+class Lasso {
+  Lasso._();
+
+  static const double _minInsideShare = 0.5;
+
+  /// Even-odd test of [point] against the closed [polygon].
+  static bool contains(List<Offset> polygon, Offset point) {
+    var inside = false;
+    for (int i = 0, j = polygon.length - 1; i < polygon.length; j = i++) {
+      final a = polygon[i];
+      final b = polygon[j];
+      if ((a.dy > point.dy) != (b.dy > point.dy) &&
+          point.dx <
+              (b.dx - a.dx) * (point.dy - a.dy) / (b.dy - a.dy) + a.dx) {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+
+  /// The strokes of [strokes] that [polygon] selects, in document order.
+  static List<Stroke> select(List<Stroke> strokes, List<Offset> polygon) {
+    if (polygon.length < 3) return <Stroke>[];
+    final lassoBounds = _offsetBounds(polygon);
+    final selected = <Stroke>[];
+    for (final stroke in strokes) {
+      final points = stroke.points;
+      if (points.isEmpty) continue;
+      if (!pointBounds(points).overlaps(lassoBounds)) continue;
+      final needed = (points.length * _minInsideShare).ceil();
+      var inside = 0;
+      for (int i = 0; i < points.length; i++) {
+        if (contains(polygon, points[i].offset)) inside++;
+        // Stop as soon as the outcome is settled either way
+        if (inside >= needed || inside + points.length - 1 - i < needed) {
+          break;
+        }
+      }
+      if (inside >= needed) selected.add(stroke);
+    }
+    return selected;
+  }
+
+  static Rect _offsetBounds(List<Offset> offsets) {
+    var bounds = Rect.fromPoints(offsets.first, offsets.first);
+    for (final offset in offsets) {
+      bounds = bounds.expandToInclude(Rect.fromPoints(offset, offset));
+    }
+    return bounds;
+  }
+}
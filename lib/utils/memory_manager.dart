@@ -1,4 +1,5 @@
 import 'package:flutter/material.dart';
+import 'dart:ui' as ui;
 import 'package:get/get.dart';
 import '../painters/sketch_painter.dart';
 import '../models/stroke.dart';
@@ -18,6 +19,10 @@ class MemoryManager {
   static const int _regularCleanupInterval = 20; // Every 20 strokes
   static const int _memoryCheckInterval = 50; // Every 50 strokes
 
+  // Approximate object sizes on a 64-bit VM, used for accounting only
+  static const int _bytesPerPoint = 72; // DrawingPoint + its Offset
+  static const int _bytesPerStroke = 128; // Stroke fields + points list
+
   /// Handle critical memory pressure situations
   /// Aggressively clears all caches to free GPU memory
   static void handleMemoryPressure() {
@@ -143,6 +148,20 @@ class MemoryManager {
     }
   }
 
+  /// Estimated bytes held by stroke data, cached stroke rasters and the
+  /// decoded background image. An accounting figure, not a heap measurement.
+  static int accountedBytes(List<Stroke> strokes, {ui.Image? background}) {
+    int total = 0;
+    for (final stroke in strokes) {
+      total += _bytesPerStroke + stroke.points.length * _bytesPerPoint;
+    }
+    total += SketchPainter.cachedImageBytes;
+    if (background != null) {
+      total += background.width * background.height * 4;
+    }
+    return total;
+  }
+
   /// Emergency cleanup when memory is critically low
   /// More aggressive than regular cleanup
   static void emergencyMemoryCleanup() {
@@ -0,0 +1,31 @@
+import 'dart:developer';
+import '../models/stroke.dart';
+
+/// Timeline spans for the painter and controller hot paths.
+///
+/// Off unless built with `--dart-define=SKETCH_TRACE=true`. Every call site
+/// is guarded by the const [kSketchTrace], so argument maps are never built
+/// and the calls are tree-shaken out of normal builds. Spans show up in
+/// DevTools and Perfetto for debug and profile builds (the VM drops timeline
+/// events in release mode).
+const bool kSketchTrace = bool.fromEnvironment('SKETCH_TRACE');
+
+class PerfTrace {
+  PerfTrace._();
+
+  static void begin(String name, [Map<String, Object?>? arguments]) {
+    Timeline.startSync(name, arguments: arguments);
+  }
+
+  static void end() {
+    Timeline.finishSync();
+  }
+
+  /// Standard arguments for a per-stroke span.
+  static Map<String, Object?> strokeArgs(Stroke stroke) => <String, Object?>{
+        'tool': stroke.tool.name,
+        'brushMode': stroke.brushMode?.name ?? 'none',
+        'points': stroke.points.length,
+        'width': stroke.width,
+      };
+}
@@ -0,0 +1,64 @@
+import 'dart:ui' show FrameTiming;
+import 'runner_metrics_stub.dart'
+    if (dart.library.ffi) 'runner_metrics_native.dart';
+
+// Indices must match the enums in linux/runner/metrics.h.
+
+enum MetricCounter {
+  frames,
+  strokesCommitted,
+  paintCacheHits,
+  paintCacheMisses,
+  exports,
+  inputEvents,
+  uiStalls,
+}
+
+enum MetricGauge {
+  strokeCount,
+  cachedImageBytes,
+  rssBytes,
+}
+
+enum MetricHistogram {
+  frameBuildUs,
+  frameRasterUs,
+  endStrokeUs,
+  exportUs,
+  uiStallUs,
+}
+
+/// Production telemetry kept by the Linux runner.
+///
+/// Counters, gauges and latency histograms live in a native region of
+/// atomics (`linux/runner/metrics.cc`). Each update is one leaf FFI call and
+/// one relaxed atomic operation. `kill -USR1 <pid>` prints them, with
+/// histogram percentiles, to stderr. On other platforms and in tests
+/// [enabled] is false and every call returns immediately.
+class RunnerMetrics {
+  RunnerMetrics._();
+
+  static final bool enabled = runnerMetricsBindings != null;
+
+  static void add(MetricCounter counter, [int delta = 1]) {
+    runnerMetricsBindings?.add(counter.index, delta);
+  }
+
+  static void set(MetricGauge gauge, int value) {
+    runnerMetricsBindings?.set(gauge.index, value);
+  }
+
+  static void record(MetricHistogram histogram, int micros) {
+    runnerMetricsBindings?.record(histogram.index, micros);
+  }
+
+  /// For `SchedulerBinding.addTimingsCallback`.
+  static void recordFrameTimings(List<FrameTiming> timings) {
+    add(MetricCounter.frames, timings.length);
+    for (final timing in timings) {
+      record(MetricHistogram.frameBuildUs, timing.buildDuration.inMicroseconds);
+      record(
+          MetricHistogram.frameRasterUs, timing.rasterDuration.inMicroseconds);
+    }
+  }
+}
@@ -0,0 +1,26 @@
+import 'dart:ffi';
+import 'dart:io';
+
+typedef MetricUpdate = void Function(int id, int value);
+typedef _MetricUpdateC = Void Function(Int32 id, Int64 value);
+
+/// Exported by the Linux runner (`linux/runner/metrics.cc`); null in other
+/// runners and `flutter test`. Leaf calls: no safepoint transition.
+final ({MetricUpdate add, MetricUpdate set, MetricUpdate record})?
+    runnerMetricsBindings = _bind();
+
+({MetricUpdate add, MetricUpdate set, MetricUpdate record})? _bind() {
+  if (!Platform.isLinux) return null;
+  try {
+    final lib = DynamicLibrary.executable();
+    MetricUpdate lookup(String name) =>
+        lib.lookupFunction<_MetricUpdateC, MetricUpdate>(name, isLeaf: true);
+    return (
+      add: lookup('sketcher_metric_add'),
+      set: lookup('sketcher_metric_set'),
+      record: lookup('sketcher_metric_record'),
+    );
+  } on ArgumentError {
+    return null;
+  }
+}
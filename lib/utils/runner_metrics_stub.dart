@@ -0,0 +1,5 @@
+typedef MetricUpdate = void Function(int id, int value);
+
+/// No FFI on this platform: metrics are not kept.
+const ({MetricUpdate add, MetricUpdate set, MetricUpdate record})?
+    runnerMetricsBindings = null;
@@ -0,0 +1,84 @@
+import 'package:flutter/foundation.dart';
+
+/// Compile-time switch for diagnostic logging: `--dart-define=SKETCH_LOG=true`.
+///
+/// Call sites guard with `if (kSketchLog)`, so in normal builds the message
+/// strings are never built and the calls are compiled out entirely.
+const bool kSketchLog = bool.fromEnvironment('SKETCH_LOG');
+
+/// One captured log line.
+class SketchLogEntry {
+  final int timeMicros;
+  final String tag;
+  final String message;
+  final Map<String, Object?>? fields;
+
+  const SketchLogEntry({
+    required this.timeMicros,
+    required this.tag,
+    required this.message,
+    this.fields,
+  });
+
+  @override
+  String toString() {
+    final buffer = StringBuffer('[$timeMicros] $tag: $message');
+    fields?.forEach((key, value) => buffer.write(' $key=$value'));
+    return buffer.toString();
+  }
+}
+
+/// Logging facade for hot paths (painting, pointer handling, undo).
+///
+/// Entries go into a fixed-size ring buffer instead of stdout, which on Linux
+/// is routed through the engine log and is expensive at frame rate. Call
+/// [dump] to get the most recent entries on demand; set [echo] to also
+/// mirror them to the console while debugging.
+class SketchLog {
+  SketchLog._();
+
+  static const int capacity = 512;
+
+  static final List<SketchLogEntry?> _ring =
+      List<SketchLogEntry?>.filled(capacity, null);
+  static final Stopwatch _clock = Stopwatch()..start();
+  static int _next = 0;
+  static int _count = 0;
+
+  /// Mirror captured entries to [debugPrint].
+  static bool echo = false;
+
+  static void log(String tag, String message, [Map<String, Object?>? fields]) {
+    final entry = SketchLogEntry(
+      timeMicros: _clock.elapsedMicroseconds,
+      tag: tag,
+      message: message,
+      fields: fields,
+    );
+    _ring[_next] = entry;
+    _next = (_next + 1) % capacity;
+    if (_count < capacity) _count++;
+    if (echo) debugPrint(entry.toString());
+  }
+
+  /// Captured entries, oldest first.
+  static List<SketchLogEntry> get entries {
+    final start = (_next - _count + capacity) % capacity;
+    return List<SketchLogEntry>.generate(
+        _count, (i) => _ring[(start + i) % capacity]!);
+  }
+
+  /// Captured entries as text, optionally only those with [tag].
+  static String dump({String? tag}) {
+    return entries
+        .where((e) => tag == null || e.tag == tag)
+        .map((e) => e.toString())
+        .join('\n');
+  }
+
+  static void clear() {
+    _ring.fillRange(0, capacity, null);
+    _next = 0;
+    _count = 0;
+  }
+}
@@ -0,0 +1,85 @@
+import 'dart:async';
+import 'package:flutter/widgets.dart';
+import '../models/brush_mode.dart';
+import '../models/drawing_tool.dart';
+import 'stall_watchdog_stub.dart'
+    if (dart.library.ffi) 'stall_watchdog_native.dart';
+
+// Indices must match WatchdogStrokeOp in linux/runner/watchdog.h.
+enum StrokeOp {
+  none,
+  startStroke,
+  addPoint,
+  endStroke,
+  undo,
+  clear,
+  loadDocument,
+  export,
+}
+
+/// Heartbeat for the Linux runner's UI-thread stall watchdog.
+///
+/// The runner's watchdog thread (`linux/runner/watchdog.cc`) logs a stall
+/// when no beat arrives within `--watchdog-ms` (default 100 ms), together
+/// with the context last passed to [note]. Beats come from every frame and
+/// every [note]. Once the task that beat is done and no frame is scheduled,
+/// the runner is told the UI thread is idle and sleeps until the next beat,
+/// so an idle canvas costs no wakeups. On other platforms and in tests
+/// [enabled] is false and every call returns immediately.
+class StallWatchdog {
+  StallWatchdog._();
+
+  static final bool enabled = stallWatchdogBindings != null;
+
+  static bool _started = false;
+  static bool _idleCheckPending = false;
+
+  /// Starts beating; call once the binding is initialized.
+  static void start() {
+    if (stallWatchdogBindings == null || _started) return;
+    _started = true;
+    SchedulerBinding.instance.addPersistentFrameCallback((_) => _beat());
+    WidgetsBinding.instance.addObserver(_LifecycleObserver());
+    _beat();
+  }
+
+  /// Records what the UI thread is about to do, for the stall log.
+  static void note(
+    StrokeOp op, {
+    required int strokes,
+    int points = 0,
+    required DrawingTool tool,
+    BrushMode? brushMode,
+  }) {
+    final bindings = stallWatchdogBindings;
+    if (bindings == null) return;
+    bindings.context(
+        op.index, strokes, points, tool.index, brushMode?.index ?? -1);
+    if (_started) _beat();
+  }
+
+  static void _beat() {
+    stallWatchdogBindings!.beat();
+    if (_idleCheckPending) return;
+    _idleCheckPending = true;
+    // Runs once the current task is over; a stalled task delays it
+    Timer.run(_idleIfQuiet);
+  }
+
+  static void _idleIfQuiet() {
+    _idleCheckPending = false;
+    final scheduler = SchedulerBinding.instance;
+    // The next frame beats and checks again
+    if (scheduler.hasScheduledFrame && scheduler.framesEnabled) return;
+    stallWatchdogBindings!.idle();
+  }
+}
+
+// A frame scheduled before the window was hidden never comes, so leaving
+// the foreground counts as idle.
+class _LifecycleObserver with WidgetsBindingObserver {
+  @override
+  void didChangeAppLifecycleState(AppLifecycleState state) {
+    if (state != AppLifecycleState.resumed) stallWatchdogBindings!.idle();
+  }
+}
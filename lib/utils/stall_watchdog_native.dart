@@ -0,0 +1,43 @@
+import 'dart:ffi';
+import 'dart:io';
+
+typedef WatchdogContext = void Function(
+    int op, int strokes, int points, int tool, int brushMode);
+typedef _WatchdogContextC = Void Function(
+    Int32 op, Int32 strokes, Int32 points, Int32 tool, Int32 brushMode);
+
+typedef _Bindings = ({
+  int thresholdMs,
+  void Function() beat,
+  void Function() idle,
+  WatchdogContext context,
+});
+
+/// Exported by the Linux runner (`linux/runner/watchdog.cc`); null in other
+/// runners, in `flutter test` and when started with `--watchdog-ms=0`.
+/// Leaf calls: no safepoint transition.
+final _Bindings? stallWatchdogBindings = _bind();
+
+_Bindings? _bind() {
+  if (!Platform.isLinux) return null;
+  try {
+    final lib = DynamicLibrary.executable();
+    final thresholdMs = lib.lookupFunction<Int32 Function(), int Function()>(
+        'sketcher_watchdog_threshold_ms')();
+    if (thresholdMs <= 0) return null;
+    return (
+      thresholdMs: thresholdMs,
+      beat: lib.lookupFunction<Void Function(), void Function()>(
+          'sketcher_watchdog_beat',
+          isLeaf: true),
+      idle: lib.lookupFunction<Void Function(), void Function()>(
+          'sketcher_watchdog_idle',
+          isLeaf: true),
+      context: lib.lookupFunction<_WatchdogContextC, WatchdogContext>(
+          'sketcher_watchdog_context',
+          isLeaf: true),
+    );
+  } on ArgumentError {
+    return null;
+  }
+}
@@ -0,0 +1,10 @@
+typedef WatchdogContext = void Function(
+    int op, int strokes, int points, int tool, int brushMode);
+
+/// No FFI on this platform: the UI thread is not watched.
+const ({
+  int thresholdMs,
+  void Function() beat,
+  void Function() idle,
+  WatchdogContext context,
+})? stallWatchdogBindings = null;
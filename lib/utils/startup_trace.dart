@@ -0,0 +1,36 @@
+import 'dart:developer';
+import 'package:flutter/services.dart';
+
+/// Dart-side marks for the Linux runner's startup trace.
+///
+/// Marks are `Timeline.now` timestamps, which share the runner's monotonic
+/// clock. They are sent over `sketcher/startup` and dropped silently where
+/// no runner listens (tests, other platforms, the headless renderer). The
+/// trace is written by the runner when `SKETCH_STARTUP_TRACE` names a file.
+class StartupTrace {
+  StartupTrace._();
+
+  static const MethodChannel _channel = MethodChannel('sketcher/startup');
+  static bool _painted = false;
+
+  /// Marks the first `SketchPainter.paint`; later calls are one bool check.
+  static void firstPaint() {
+    if (_painted) return;
+    _painted = true;
+    mark('dart_first_paint');
+  }
+
+  /// Sends [name], taken at [micros] (default: now).
+  static void mark(String name, [int? micros]) {
+    _send(name, micros ?? Timeline.now);
+  }
+
+  static Future<void> _send(String name, int micros) async {
+    try {
+      await _channel.invokeMethod<void>(
+          'mark', <String, Object>{'name': name, 'ts': micros});
+    } catch (_) {
+      // No runner channel, or no binding yet in plain unit tests
+    }
+  }
+}
@@ -0,0 +1,174 @@
+import 'dart:math' as math;
+import 'dart:ui';
+import '../models/stroke.dart';
+
+/// Shortest distance from [p] to the segment [a]–[b].
+double distanceToSegment(Offset p, Offset a, Offset b) {
+  final ab = b - a;
+  final lengthSquared = ab.distanceSquared;
+  if (lengthSquared == 0) return (p - a).distance;
+  final ap = p - a;
+  final t = ((ap.dx * ab.dx + ap.dy * ab.dy) / lengthSquared).clamp(0.0, 1.0);
+  return (p - (a + ab * t)).distance;
+}
+
+/// Smallest rectangle holding every point; the points must not be empty.
+Rect pointBounds(List<DrawingPoint> points) {
+  var left = points.first.offset.dx;
+  var right = left;
+  var top = points.first.offset.dy;
+  var bottom = top;
+  for (final point in points) {
+    left = math.min(left, point.offset.dx);
+    right = math.max(right, point.offset.dx);
+    top = math.min(top, point.offset.dy);
+    bottom = math.max(bottom, point.offset.dy);
+  }
+  return Rect.fromLTRB(left, top, right, bottom);
+}
+
+/// Shortest distance between the segments [a]–[b] and [c]–[d].
+double segmentDistance(Offset a, Offset b, Offset c, Offset d) {
+  if (_segmentsCross(a, b, c, d)) return 0.0;
+  return math.min(
+    math.min(distanceToSegment(a, c, d), distanceToSegment(b, c, d)),
+    math.min(distanceToSegment(c, a, b), distanceToSegment(d, a, b)),
+  );
+}
+
+double _cross(Offset o, Offset a, Offset b) =>
+    (a.dx - o.dx) * (b.dy - o.dy) - (a.dy - o.dy) * (b.dx - o.dx);
+
+// Proper crossings only; touching and collinear cases come out of the
+// endpoint distances as zero anyway.
+bool _segmentsCross(Offset a, Offset b, Offset c, Offset d) {
+  final d1 = _cross(c, d, a);
+  final d2 = _cross(c, d, b);
+  final d3 = _cross(a, b, c);
+  final d4 = _cross(a, b, d);
+  return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+      ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0));
+}
+
+/// One segment of an indexed stroke: points `index` and `index + 1`, or the
+/// lone point of a one-point stroke.
+class _SegmentRef {
+  final Stroke stroke;
+  final int index;
+
+  const _SegmentRef(this.stroke, this.index);
+
+  Offset get a => stroke.points[index].offset;
+
+  Offset get b =>
+      stroke.points[math.min(index + 1, stroke.points.length - 1)].offset;
+}
+
+/// Uniform grid over the segments of committed strokes.
+///
+/// Every segment is filed under each cell its bounds touch, inflated by half
+/// the stroke width, so a query only looks at segments near the query path
+/// instead of every point in the document. Strokes are immutable, so the
+/// index keys on stroke identity and [sync] brings it up to date with the
+/// controller's list by adding and removing the difference.
+class StrokeIndex {
+  StrokeIndex({this.cellSize = 64.0});
+
+  final double cellSize;
+
+  final Map<int, List<_SegmentRef>> _cells = <int, List<_SegmentRef>>{};
+  final Map<Stroke, List<int>> _cellsByStroke =
+      Map<Stroke, List<int>>.identity();
+
+  int get length => _cellsByStroke.length;
+
+  bool contains(Stroke stroke) => _cellsByStroke.containsKey(stroke);
+
+  // Cells are packed into one int; ±32768 cells covers any canvas.
+  static int _key(int cx, int cy) => ((cx + 0x8000) << 16) | (cy + 0x8000);
+
+  int _cell(double v) => (v / cellSize).floor().clamp(-0x8000, 0x7FFF);
+
+  void add(Stroke stroke) {
+    if (stroke.points.isEmpty || contains(stroke)) return;
+    final keys = <int>{};
+    final inflate = stroke.width / 2;
+    final segments = math.max(1, stroke.points.length - 1);
+    for (int i = 0; i < segments; i++) {
+      final ref = _SegmentRef(stroke, i);
+      final bounds = Rect.fromPoints(ref.a, ref.b).inflate(inflate);
+      for (int cx = _cell(bounds.left); cx <= _cell(bounds.right); cx++) {
+        for (int cy = _cell(bounds.top); cy <= _cell(bounds.bottom); cy++) {
+          final key = _key(cx, cy);
+          (_cells[key] ??= <_SegmentRef>[]).add(ref);
+          keys.add(key);
+        }
+      }
+    }
+    _cellsByStroke[stroke] = keys.toList();
+  }
+
+  void remove(Stroke stroke) {
+    final keys = _cellsByStroke.remove(stroke);
+    if (keys == null) return;
+    for (final key in keys) {
+      final refs = _cells[key]!;
+      refs.removeWhere((ref) => identical(ref.stroke, stroke));
+      if (refs.isEmpty) _cells.remove(key);
+    }
+  }
+
+  /// Makes the index hold exactly those of [strokes] that pass [where].
+  void sync(List<Stroke> strokes, {bool Function(Stroke)? where}) {
+    final wanted = Set<Stroke>.identity();
+    for (final stroke in strokes) {
+      if (where == null || where(stroke)) wanted.add(stroke);
+    }
+    for (final stroke in _cellsByStroke.keys.toList()) {
+      if (!wanted.contains(stroke)) remove(stroke);
+    }
+    for (final stroke in wanted) {
+      add(stroke);
+    }
+  }
+
+  void clear() {
+    _cells.clear();
+    _cellsByStroke.clear();
+  }
+
+  /// Indexed strokes whose inked area comes within [radius] of the segment
+  /// [a]–[b]. Pass the same point twice to test a single position.
+  Set<Stroke> strokesTouching(Offset a, Offset b, double radius) {
+    final hits = Set<Stroke>.identity();
+    if (_cells.isEmpty) return hits;
+    final bounds = Rect.fromPoints(a, b).inflate(radius);
+    for (int cx = _cell(bounds.left); cx <= _cell(bounds.right); cx++) {
+      for (int cy = _cell(bounds.top); cy <= _cell(bounds.bottom); cy++) {
+        final refs = _cells[_key(cx, cy)];
+        if (refs == null) continue;
+        for (final ref in refs) {
+          if (hits.contains(ref.stroke)) continue;
+          final reach = radius + ref.stroke.width / 2;
+          if (segmentDistance(a, b, ref.a, ref.b) <= reach) {
+            hits.add(ref.stroke);
+          }
+        }
+      }
+    }
+    return hits;
+  }
+
+  /// Indexed strokes touched anywhere along the polyline [path].
+  Set<Stroke> strokesAlong(List<Offset> path, double radius) {
+    if (path.isEmpty) return Set<Stroke>.identity();
+    if (path.length == 1) {
+      return strokesTouching(path.first, path.first, radius);
+    }
+    final hits = Set<Stroke>.identity();
+    for (int i = 0; i < path.length - 1; i++) {
+      hits.addAll(strokesTouching(path[i], path[i + 1], radius));
+    }
+    return hits;
+  }
+}
@@ -0,0 +1,82 @@
+import 'dart:typed_data';
+import '../models/stroke.dart';
+
+/// Counter-based noise for brush textures.
+///
+/// Maps `(seed, index, k)` straight to a value with a stateless integer hash
+/// instead of drawing from a sequential `math.Random`. Texture for a given
+/// point therefore never depends on loop order, costs no allocation, and is
+/// identical wherever the same stroke is rendered (live preview or committed).
+///
+/// All arithmetic is kept in 32 bits so results match on the VM and the web.
+class StrokeNoise {
+  StrokeNoise._();
+
+  static const int _mask32 = 0xFFFFFFFF;
+  static const double _inv32 = 1.0 / 4294967296.0;
+  // Largest float32 below 1.0
+  static const double _maxUnit32 = 1.0 - 1.0 / 16777216.0;
+
+  /// Stable per-stroke seed.
+  ///
+  /// Derived from the first point only: `endStroke` smoothing keeps the first
+  /// point untouched, so the live stroke and its committed copy share a seed.
+  static int seedFor(Stroke stroke) {
+    if (stroke.points.isEmpty) return 0;
+    final first = stroke.points.first;
+    final ts = first.timestamp.toInt();
+    var h = _mix(ts & _mask32);
+    h = _mix(h ^ ((ts ~/ 4294967296) & _mask32));
+    h = _mix(h ^ (first.offset.dx.round() & _mask32));
+    h = _mix(h ^ _mul32(first.offset.dy.round() & _mask32, 0x9E3779B1));
+    return h;
+  }
+
+  /// Raw 32-bit hash of `(seed, index, k)`.
+  static int hash(int seed, int index, int k) {
+    var h = _mix((seed ^ _mul32(index & _mask32, 0x9E3779B1)) & _mask32);
+    h = _mix(h ^ _mul32((k + 1) & _mask32, 0x85EBCA77));
+    return h;
+  }
+
+  /// Uniform value in `[0, 1)`.
+  static double unit(int seed, int index, int k) =>
+      hash(seed, index, k) * _inv32;
+
+  /// Uniform value in `[-1, 1)`.
+  static double signed(int seed, int index, int k) =>
+      unit(seed, index, k) * 2.0 - 1.0;
+
+  /// Fills [out] with `unit(seed, index, kStart + j)` for every slot `j`.
+  ///
+  /// Lets a draw loop fetch all values for one point in a single pass over a
+  /// preallocated buffer. Values that would round up to 1.0 in float32 are
+  /// stored as the largest float32 below it, so the range stays `[0, 1)`.
+  static void fill(Float32List out, int seed, int index, [int kStart = 0]) {
+    final base = (seed ^ _mul32(index & _mask32, 0x9E3779B1)) & _mask32;
+    final h0 = _mix(base);
+    for (int j = 0; j < out.length; j++) {
+      final v = _mix(h0 ^ _mul32((kStart + j + 1) & _mask32, 0x85EBCA77)) *
+          _inv32;
+      out[j] = v < _maxUnit32 ? v : _maxUnit32;
+    }
+  }
+
+  // lowbias32 finalizer (SplitMix-style avalanche on 32 bits).
+  static int _mix(int h) {
+    h &= _mask32;
+    h ^= h >>> 16;
+    h = _mul32(h, 0x7FEB352D);
+    h ^= h >>> 15;
+    h = _mul32(h, 0x846CA68B);
+    h ^= h >>> 16;
+    return h;
+  }
+
+  // 32-bit wrapping multiply that stays exact under JS double arithmetic.
+  static int _mul32(int a, int b) {
+    final lo = (a & 0xFFFF) * b;
+    final hi = ((a >>> 16) * b) & 0xFFFF;
+    return (lo + (hi << 16)) & _mask32;
+  }
+}
@@ -0,0 +1,206 @@
+import 'dart:math' as math;
+import 'dart:ui';
+import '../models/drawing_tool.dart';
+import '../models/stroke.dart';
+import 'stroke_index.dart';
+
+/// Cuts strokes along an eraser path instead of painting over them.
+///
+/// A stroke point is erased when it lies within the eraser's radius plus
+/// half the stroke width of the eraser path, so the round caps of the
+/// surviving fragments end at the eraser's edge, where a pixel eraser would
+/// have cleared them. Segments that pass near the path are subdivided and
+/// the cut points found by bisection, with pressure, timestamp and tilt
+/// interpolated. Everything else about a fragment is copied from its stroke.
+class VectorEraser {
+  VectorEraser._();
+
+  // Subdivision step as a share of the erase distance, and bisection steps
+  // per cut; together they place a cut to within a few hundredths of a pixel.
+  static const double _stepFactor = 0.25;
+  static const int _bisectSteps = 8;
+  // Shorter fragments are slivers left at the cut and are dropped.
+  static const double _minFragmentLength = 0.5;
+
+  /// Whether [stroke] is geometry the vector eraser may cut.
+  static bool canSplit(Stroke stroke) {
+    if (stroke.isEraser) return false;
+    switch (stroke.tool) {
+      case DrawingTool.pencil:
+      case DrawingTool.pen:
+      case DrawingTool.marker:
+        return true;
+      case DrawingTool.eraser:
+      case DrawingTool.brush:
+        return false;
+    }
+  }
+
+  /// Applies the eraser [path] of half-width [radius] to [strokes].
+  ///
+  /// Returns a new list with every touched stroke replaced in place by its
+  /// surviving fragments, or null if nothing was touched. Untouched strokes
+  /// keep their identity, and so their paint caches. Candidates come from
+  /// [index]; those that [canSplit] rejects are kept as they are.
+  static List<Stroke>? apply(
+    List<Stroke> strokes,
+    List<Offset> path,
+    double radius,
+    StrokeIndex index, {
+    void Function(Stroke removed)? onRemoved,
+  }) {
+    final candidates = index.strokesAlong(path, radius);
+    if (candidates.isEmpty) return null;
+
+    final result = <Stroke>[];
+    var changed = false;
+    for (final stroke in strokes) {
+      if (!candidates.contains(stroke) || !canSplit(stroke)) {
+        result.add(stroke);
+        continue;
+      }
+      final fragments = split(stroke, path, radius);
+      if (fragments == null) {
+        result.add(stroke);
+        continue;
+      }
+      result.addAll(fragments);
+      onRemoved?.call(stroke);
+      changed = true;
+    }
+    return changed ? result : null;
+  }
+
+  /// The pieces of [stroke] left outside the eraser [path], or null if the
+  /// eraser does not reach it. An empty list means it was erased entirely.
+  static List<Stroke>? split(Stroke stroke, List<Offset> path, double radius) {
+    final points = stroke.points;
+    if (points.isEmpty || path.isEmpty) return null;
+    final reach = radius + stroke.width / 2;
+
+    // Only eraser segments that come near this stroke are worth testing.
+    final bounds = pointBounds(points).inflate(reach);
+    final eraser = <Offset>[];
+    final segments = path.length == 1 ? 1 : path.length - 1;
+    for (int i = 0; i < segments; i++) {
+      final a = path[i];
+      final b = path[math.min(i + 1, path.length - 1)];
+      if (Rect.fromPoints(a, b).overlaps(bounds)) eraser..add(a)..add(b);
+    }
+    if (eraser.isEmpty) return null;
+
+    double distance(Offset p) {
+      var best = double.infinity;
+      for (int i = 0; i < eraser.length; i += 2) {
+        best = math.min(best, distanceToSegment(p, eraser[i], eraser[i + 1]));
+      }
+      return best;
+    }
+
+    bool segmentNear(Offset a, Offset b) {
+      for (int i = 0; i < eraser.length; i += 2) {
+        if (segmentDistance(a, b, eraser[i], eraser[i + 1]) <= reach) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    if (points.length == 1) {
+      return distance(points.first.offset) <= reach ? <Stroke>[] : null;
+    }
+
+    final fragments = <List<DrawingPoint>>[];
+    var current = <DrawingPoint>[];
+    var touched = false;
+    var previousInside = distance(points.first.offset) <= reach;
+    if (previousInside) {
+      touched = true;
+    } else {
+      current.add(points.first);
+    }
+
+    for (int i = 1; i < points.length; i++) {
+      final from = points[i - 1];
+      final to = points[i];
+      if (!segmentNear(from.offset, to.offset)) {
+        // Both ends are outside too, so the run just continues.
+        current.add(to);
+        previousInside = false;
+        continue;
+      }
+      final length = (to.offset - from.offset).distance;
+      final steps = math.max(1, (length / (reach * _stepFactor)).ceil());
+      var t0 = 0.0;
+      for (int s = 1; s <= steps; s++) {
+        final t1 = s / steps;
+        final sample = s == steps ? to : _lerp(from, to, t1);
+        final inside = distance(sample.offset) <= reach;
+        if (inside != previousInside) {
+          touched = true;
+          final cut = _lerp(from, to,
+              _bisect(from, to, t0, t1, previousInside, distance, reach));
+          if (inside) {
+            current.add(cut);
+            fragments.add(current);
+            current = <DrawingPoint>[];
+          } else {
+            current.add(cut);
+          }
+        }
+        if (!inside) current.add(sample);
+        previousInside = inside;
+        t0 = t1;
+      }
+    }
+    fragments.add(current);
+
+    if (!touched) return null;
+    return [
+      for (final fragment in fragments)
+        if (_length(fragment) >= _minFragmentLength)
+          stroke.copyWith(points: fragment),
+    ];
+  }
+
+  // Parameter of the inside/outside boundary between t0 and t1.
+  static double _bisect(
+    DrawingPoint from,
+    DrawingPoint to,
+    double t0,
+    double t1,
+    bool insideAtT0,
+    double Function(Offset) distance,
+    double reach,
+  ) {
+    for (int i = 0; i < _bisectSteps; i++) {
+      final mid = (t0 + t1) / 2;
+      final offset = Offset.lerp(from.offset, to.offset, mid)!;
+      if ((distance(offset) <= reach) == insideAtT0) {
+        t0 = mid;
+      } else {
+        t1 = mid;
+      }
+    }
+    return (t0 + t1) / 2;
+  }
+
+  static DrawingPoint _lerp(DrawingPoint a, DrawingPoint b, double t) {
+    double mix(double x, double y) => x + (y - x) * t;
+    return DrawingPoint(
+      offset: Offset.lerp(a.offset, b.offset, t)!,
+      pressure: mix(a.pressure, b.pressure),
+      timestamp: mix(a.timestamp, b.timestamp),
+      tiltX: mix(a.tiltX, b.tiltX),
+      tiltY: mix(a.tiltY, b.tiltY),
+    );
+  }
+
+  static double _length(List<DrawingPoint> points) {
+    var total = 0.0;
+    for (int i = 1; i < points.length; i++) {
+      total += (points[i].offset - points[i - 1].offset).distance;
+    }
+    return total;
+  }
+}
@@ -2,25 +2,45 @@ import 'package:flutter/material.dart';
 import 'dart:typed_data';
 import 'dart:ui' as ui;
 import 'dart:async'; // Added for Completer and TimeoutException
+import 'dart:io';
 import 'package:flutter/services.dart';
 import 'package:flutter/rendering.dart';
 import 'package:get/get.dart';
 import 'package:image_picker/image_picker.dart';
 import 'package:flutter_colorpicker/flutter_colorpicker.dart';
+import 'package:path/path.dart' as p;
+import 'package:path_provider/path_provider.dart';
 // Syncfusion imports removed after reverting to Material Slider for tests
 import '../controllers/sketch_controller.dart';
+import '../painters/selection_painter.dart';
 import '../painters/sketch_painter.dart';
 import '../models/drawing_tool.dart';
 import '../models/stroke.dart';
 import '../models/brush_mode.dart';
+import '../models/eraser_mode.dart';
+import '../models/input_session.dart';
+import '../models/sketch_layer.dart';
+import '../utils/input_recorder.dart';
+import '../utils/image_tracker.dart';
+import '../utils/input_replayer.dart';
+import '../utils/runner_metrics.dart';
+import '../utils/sketch_log.dart';
+import '../utils/stall_watchdog.dart';
+import 'perf_overlay.dart';
 
 class DrawingCanvas extends StatefulWidget {
-  const DrawingCanvas({Key? key}) : super(key: key);
+  /// Input to replay after the first frame (benchmark mode).
+  final CanvasReplay? replay;
+
+  const DrawingCanvas({Key? key, this.replay}) : super(key: key);
 
   @override
   State<DrawingCanvas> createState() => _DrawingCanvasState();
 }
 
+/// What a single-pointer drag does in lasso mode.
+enum _SelectionDrag { none, lasso, move, scaleRotate }
+
 class _DrawingCanvasState extends State<DrawingCanvas> {
   late final SketchController controller;
   final GlobalKey _repaintKey = GlobalKey();
@@ -34,264 +54,180 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
   static const double _touchSlop = 8.0;
   bool _controlsExpanded = true;
 
+  // Lasso mode: what the current single-pointer drag does, and the
+  // selection recorded for it
+  _SelectionDrag _selectionDrag = _SelectionDrag.none;
+  ui.Picture? _selectionPicture;
+
   // Phase 2: Async image loading state
   bool _isLoadingImage = false;
   String? _imageLoadError;
 
+  // Input session record / replay
+  final InputRecorder _recorder = InputRecorder();
+  final List<Worker> _recordWorkers = <Worker>[];
+  InputSession? _lastSession;
+  InputReplayer? _replayer;
+
   @override
   Widget build(BuildContext context) {
     return Column(
       children: [
         _buildToolbar(),
         Expanded(
-          child: LayoutBuilder(
-            builder: (context, constraints) {
-              return Listener(
-                onPointerDown: (event) {
-                  // Phase 3: Error boundary for pointer down events
-                  try {
-                    // ignore: avoid_print
-                    print('👆 pointer down');
-                    final newCount = (_pointerCount + 1).clamp(0, 10);
-                    final scenePos = controller.transformationController
-                        .toScene(event.localPosition);
-                    final isStylus =
-                        event.kind == ui.PointerDeviceKind.stylus ||
-                            event.kind == ui.PointerDeviceKind.invertedStylus;
-                    final isMouse = event.kind == ui.PointerDeviceKind.mouse;
-                    final inputAllowed = !controller.stylusOnlyMode.value
-                        ? true
-                        : (isStylus || isMouse);
-
-                    if (newCount == 1 && inputAllowed) {
-                      // Defer starting stroke until we see movement or a tap completes.
-                      _downPos = scenePos;
-                      _pendingTap = true;
-                      _cursorPos = scenePos;
-                    } else {
-                      // Multi-touch: cancel any pending tap or drawing.
-                      _pendingTap = false;
-                      if (_isDrawing) {
-                        _isDrawing = false;
-                        controller.endStroke();
-                        _cursorPos = null;
-                      }
-                    }
-                    _pointerCount = newCount;
-                    setState(() {});
-                  } catch (e) {
-                    debugPrint('Pointer down error: $e');
-                    // Graceful recovery: reset drawing state
-                    _cancelDrawing();
-                  }
-                },
-                onPointerMove: (event) {
-                  // Phase 3: Error boundary for pointer move events
-                  try {
-                    final isStylus =
-                        event.kind == ui.PointerDeviceKind.stylus ||
-                            event.kind == ui.PointerDeviceKind.invertedStylus;
-                    final isMouse = event.kind == ui.PointerDeviceKind.mouse;
-                    final inputAllowed = !controller.stylusOnlyMode.value
-                        ? true
-                        : (isStylus || isMouse);
-                    if (_pointerCount == 1 && inputAllowed) {
-                      final scenePos = controller.transformationController
-                          .toScene(event.localPosition);
-                      // Extract stylus tilt data for enhanced drawing (available on supported devices)
-                      final tiltX =
-                          event.orientation; // Stylus orientation/tilt
-                      final tiltY =
-                          0.0; // Flutter doesn't expose separate tiltY yet
-
-                      if (!_isDrawing && _pendingTap && _downPos != null) {
-                        final moved = (scenePos - _downPos!).distance;
-                        // Adjust touch slop based on zoom level - at high zoom, use smaller slop in scene coordinates
-                        final zoomScale = controller
-                            .transformationController.value
-                            .getMaxScaleOnAxis();
-                        final adjustedTouchSlop = _touchSlop / zoomScale;
-                        if (moved >= adjustedTouchSlop) {
-                          // Start drawing after surpassing touch slop.
-                          _isDrawing = true;
-                          _pendingTap = false;
-                          HapticFeedback.lightImpact();
-                          controller.startStroke(_downPos!, 1.0,
-                              tiltX: tiltX, tiltY: tiltY);
-                          controller.addPoint(scenePos, 1.0,
-                              tiltX: tiltX, tiltY: tiltY);
-                        }
-                      } else if (_isDrawing) {
-                        controller.addPoint(scenePos, 1.0,
-                            tiltX: tiltX, tiltY: tiltY);
-                      }
-                      _cursorPos = scenePos;
-                      setState(() {});
-                    }
-                  } catch (e) {
-                    debugPrint('Pointer move error: $e');
-                    // Graceful recovery: maintain current state or cancel if critical error
-                    if (_isDrawing) {
-                      try {
-                        controller.endStroke();
-                      } catch (endError) {
-                        debugPrint(
-                            'Error ending stroke in move error recovery: $endError');
-                      }
-                      _cancelDrawing();
+          child: Stack(
+            fit: StackFit.expand,
+            children: [
+              _buildCanvasArea(),
+              GetBuilder<SketchController>(builder: (_) {
+                if (!controller.showPerfOverlay.value) {
+                  return const SizedBox.shrink();
+                }
+                return Positioned(
+                  top: 8,
+                  left: 8,
+                  child: IgnorePointer(
+                    child: PerfOverlay(
+                      controller: controller,
+                      backgroundImage: _backgroundImageData,
+                    ),
+                  ),
+                );
+              }),
+            ],
+          ),
+        ),
+        _buildInlineControls(),
+      ],
+    );
+  }
+
+  Widget _buildCanvasArea() {
+    return LayoutBuilder(
+      builder: (context, constraints) {
+        return Listener(
+          onPointerDown: _handlePointerDown,
+          onPointerMove: _handlePointerMove,
+          onPointerUp: _handlePointerUp,
+          onPointerCancel: _handlePointerCancel,
+          child: GestureDetector(
+            behavior: HitTestBehavior.opaque,
+            key: const Key('drawing-area'),
+            child: InteractiveViewer(
+              transformationController:
+                  controller.transformationController,
+              panEnabled: _pointerCount >= 2,
+              scaleEnabled: _pointerCount >= 2,
+              boundaryMargin: const EdgeInsets.all(1000),
+              minScale: 0.5,
+              maxScale: 8.0,
+              clipBehavior: Clip.none,
+              child: Stack(
+                fit: StackFit.expand,
+                children: [
+                  GetBuilder<SketchController>(builder: (_) {
+                    if (controller.imageRect.value == null &&
+                        _backgroundImageData != null) {
+                      WidgetsBinding.instance.addPostFrameCallback((_) {
+                        final sz = Size(
+                            constraints.maxWidth, constraints.maxHeight);
+                        final rect = _computeAnchoredImageRect(
+                            sz, _backgroundImageData!);
+                        controller.imageRect.value = rect;
+                        controller.update();
+                      });
                     }
-                  }
-                },
-                onPointerUp: (event) {
-                  // Phase 3: Error boundary for pointer up events
-                  try {
-                    // ignore: avoid_print
-                    print('👇 pointer up');
-                    final isStylus =
-                        event.kind == ui.PointerDeviceKind.stylus ||
-                            event.kind == ui.PointerDeviceKind.invertedStylus;
-                    final isMouse = event.kind == ui.PointerDeviceKind.mouse;
-                    final inputAllowed = !controller.stylusOnlyMode.value
-                        ? true
-                        : (isStylus || isMouse);
-                    if (_pointerCount == 1 && inputAllowed) {
-                      if (_isDrawing) {
-                        _isDrawing = false;
-                        controller.endStroke();
-                        _cursorPos = null;
-                      } else if (_pendingTap && _downPos != null) {
-                        // Treat as a dot tap if no multitouch occurred and no move beyond slop.
-                        final tiltX = event.orientation;
-                        final tiltY = 0.0;
-                        controller.startStroke(_downPos!, 1.0,
-                            tiltX: tiltX, tiltY: tiltY);
-                        controller.endStroke();
-                        _cursorPos = null;
+                    return RepaintBoundary(
+                      key: _repaintKey,
+                      child: CustomPaint(
+                        painter: SketchPainter(
+                          strokes: controller.isTransformingSelection
+                              ? controller.unselectedStrokes
+                              : List<Stroke>.from(controller.strokes),
+                          currentStroke: controller.currentStroke,
+                          backgroundImage:
+                              controller.backgroundImage.value,
+                          imageOpacity: controller.imageOpacity.value,
+                          isImageVisible: controller.isImageVisible.value,
+                          backgroundImageData: _backgroundImageData,
+                          viewport: _computeSceneViewport(constraints),
+                          anchoredImageRect: controller.imageRect.value,
+                          layers: List<SketchLayer>.of(controller.layers),
+                          activeLayer: controller.activeLayerIndex.value,
+                        ),
+                        child: const SizedBox.expand(),
+                      ),
+                    );
+                  }),
+                  GetBuilder<SketchController>(
+                    id: SketchController.selectionLayer,
+                    builder: (_) {
+                      if (!controller.lassoMode.value) {
+                        return const SizedBox.shrink();
                       }
-                      _pendingTap = false;
-                      _downPos = null;
-                    }
-                    _pointerCount = (_pointerCount - 1).clamp(0, 10);
-                    setState(() {});
-                  } catch (e) {
-                    debugPrint('Pointer up error: $e');
-                    // Graceful recovery: ensure clean state
-                    _cancelDrawing();
-                  }
-                },
-                onPointerCancel: (event) {
-                  // Phase 3: Error boundary for pointer cancel events
-                  try {
-                    // ignore: avoid_print
-                    print('❌ pointer cancel');
-                    if (_isDrawing) {
-                      _isDrawing = false;
-                      controller.endStroke();
-                      _cursorPos = null;
+                      return IgnorePointer(
+                        child: RepaintBoundary(
+                          child: CustomPaint(
+                            painter: SelectionPainter(
+                              picture: controller.isTransformingSelection
+                                  ? _selectionPicture
+                                  : null,
+                              transform: controller.selectionTransform,
+                              bounds: controller.selectionBounds,
+                              lassoPath:
+                                  List<Offset>.of(controller.lassoPath),
+                              pixel: 1.0 / controller.zoomScale,
+                            ),
+                            child: const SizedBox.expand(),
+                          ),
+                        ),
+                      );
+                    },
+                  ),
+                  GetBuilder<SketchController>(builder: (_) {
+                    if (_cursorPos == null ||
+                        controller.lassoMode.value ||
+                        controller.currentTool.value !=
+                            DrawingTool.eraser) {
+                      return const SizedBox.shrink();
                     }
-                    _pendingTap = false;
-                    _downPos = null;
-
-                    _pointerCount = (_pointerCount - 1).clamp(0, 10);
-                    setState(() {});
-                  } catch (e) {
-                    debugPrint('Pointer cancel error: $e');
-                    // Graceful recovery: force clean state
-                    _cancelDrawing();
-                  }
-                },
-                child: GestureDetector(
-                  behavior: HitTestBehavior.opaque,
-                  key: const Key('drawing-area'),
-                  child: InteractiveViewer(
-                    transformationController:
-                        controller.transformationController,
-                    panEnabled: _pointerCount >= 2,
-                    scaleEnabled: _pointerCount >= 2,
-                    boundaryMargin: const EdgeInsets.all(1000),
-                    minScale: 0.5,
-                    maxScale: 8.0,
-                    clipBehavior: Clip.none,
-                    child: Stack(
-                      fit: StackFit.expand,
-                      children: [
-                        GetBuilder<SketchController>(builder: (_) {
-                          if (controller.imageRect.value == null &&
-                              _backgroundImageData != null) {
-                            WidgetsBinding.instance.addPostFrameCallback((_) {
-                              final sz = Size(
-                                  constraints.maxWidth, constraints.maxHeight);
-                              final rect = _computeAnchoredImageRect(
-                                  sz, _backgroundImageData!);
-                              controller.imageRect.value = rect;
-                              controller.update();
-                            });
-                          }
-                          return RepaintBoundary(
-                            key: _repaintKey,
-                            child: CustomPaint(
-                              painter: SketchPainter(
-                                strokes: List<Stroke>.from(controller.strokes),
-                                currentStroke: controller.currentStroke,
-                                backgroundImage:
-                                    controller.backgroundImage.value,
-                                imageOpacity: controller.imageOpacity.value,
-                                isImageVisible: controller.isImageVisible.value,
-                                backgroundImageData: _backgroundImageData,
-                                viewport: _computeSceneViewport(constraints),
-                                anchoredImageRect: controller.imageRect.value,
+                    final d = controller.brushSize.value;
+                    return Positioned(
+                      left: _cursorPos!.dx - d / 2,
+                      top: _cursorPos!.dy - d / 2,
+                      width: d,
+                      height: d,
+                      child: IgnorePointer(
+                        child: Stack(children: [
+                          Container(
+                            decoration: BoxDecoration(
+                              shape: BoxShape.circle,
+                              border: Border.all(
+                                color: Colors.black.withOpacity(0.7),
+                                width: 1,
                               ),
-                              child: const SizedBox.expand(),
                             ),
-                          );
-                        }),
-                        GetBuilder<SketchController>(builder: (_) {
-                          if (_cursorPos == null ||
-                              controller.currentTool.value !=
-                                  DrawingTool.eraser) {
-                            return const SizedBox.shrink();
-                          }
-                          final d = controller.brushSize.value;
-                          return Positioned(
-                            left: _cursorPos!.dx - d / 2,
-                            top: _cursorPos!.dy - d / 2,
-                            width: d,
-                            height: d,
-                            child: IgnorePointer(
-                              child: Stack(children: [
-                                Container(
-                                  decoration: BoxDecoration(
-                                    shape: BoxShape.circle,
-                                    border: Border.all(
-                                      color: Colors.black.withOpacity(0.7),
-                                      width: 1,
-                                    ),
-                                  ),
-                                ),
-                                Container(
-                                  margin: const EdgeInsets.all(1.5),
-                                  decoration: BoxDecoration(
-                                    shape: BoxShape.circle,
-                                    border: Border.all(
-                                      color: Colors.white.withOpacity(0.9),
-                                      width: 1,
-                                    ),
-                                  ),
-                                ),
-                              ]),
+                          ),
+                          Container(
+                            margin: const EdgeInsets.all(1.5),
+                            decoration: BoxDecoration(
+                              shape: BoxShape.circle,
+                              border: Border.all(
+                                color: Colors.white.withOpacity(0.9),
+                                width: 1,
+                              ),
                             ),
-                          );
-                        }),
-                      ],
-                    ),
-                  ),
-                ),
-              );
-            },
+                          ),
+                        ]),
+                      ),
+                    );
+                  }),
+                ],
+              ),
+            ),
           ),
-        ),
-        _buildInlineControls(),
-      ],
+        );
+      },
     );
   }
 
@@ -306,6 +242,31 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
 
     // Phase 2: Listen to background image changes and load asynchronously
     ever(controller.backgroundImage, _handleImageChange);
+
+    // Setting changes are captured while a session is being recorded
+    _recordWorkers.addAll([
+      ever(controller.currentTool, _recorder.recordTool),
+      ever(controller.currentBrushMode, _recorder.recordBrushMode),
+      ever(controller.brushSize, _recorder.recordBrushSize),
+      ever(controller.currentColor,
+          (Color color) => _recorder.recordColor(color.value)),
+      ever(controller.toolOpacity, _recorder.recordOpacity),
+      ever(controller.eraserMode, _recorder.recordEraserMode),
+      ever(controller.lassoMode, _recorder.recordLassoMode),
+    ]);
+    controller.transformationController.addListener(_recordView);
+
+    final replay = widget.replay;
+    if (replay != null) {
+      WidgetsBinding.instance.addPostFrameCallback((_) async {
+        try {
+          await _replaySession(replay.session, speed: replay.speed);
+          replay.complete();
+        } catch (e, stackTrace) {
+          replay.complete(e, stackTrace);
+        }
+      });
+    }
   }
 
   // Phase 2: Async image loading methods
@@ -322,6 +283,18 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
     _loadImageAsync(imageProvider);
   }
 
+  // Removes the reference image. The decoded image is disposed here: once
+  // the field is cleared, the backgroundImage worker has nothing to dispose.
+  void _removeBackgroundImage() {
+    setState(() {
+      _backgroundImageData?.dispose();
+      _backgroundImageData = null;
+    });
+    controller.setBackgroundImage(null);
+    controller.isImageVisible.value = false;
+    controller.update();
+  }
+
   Future<void> _loadImageAsync(ImageProvider imageProvider) async {
     if (_isLoadingImage) return; // Prevent concurrent loads
 
@@ -340,7 +313,8 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
         (ImageInfo image, bool synchronousCall) {
           stream.removeListener(listener);
           if (!completer.isCompleted) {
-            completer.complete(image.image);
+            completer.complete(ImageTracker.image(
+                image.image, 'DrawingCanvas.backgroundImage'));
           }
         },
         onError: (dynamic exception, StackTrace? stackTrace) {
@@ -374,6 +348,8 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
           final rect = _computeAnchoredImageRect(renderBox.size, image);
           controller.imageRect.value = rect;
         }
+      } else {
+        image.dispose(); // Unmounted while loading: nobody owns it now
       }
     } catch (e) {
       debugPrint('Image load failed: $e');
@@ -397,10 +373,105 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
 
   @override
   void dispose() {
+    _replayer?.cancel();
+    for (final worker in _recordWorkers) {
+      worker.dispose();
+    }
+    controller.transformationController.removeListener(_recordView);
     _backgroundImageData?.dispose(); // CRITICAL: Clean up on disposal
+    _selectionPicture?.dispose();
     super.dispose();
   }
 
+  void _recordView() {
+    if (!_recorder.isRecording) return;
+    final matrix = controller.transformationController.value;
+    final translation = matrix.getTranslation();
+    _recorder.recordView(
+        matrix.getMaxScaleOnAxis(), Offset(translation.x, translation.y));
+  }
+
+  Future<void> _toggleRecording() async {
+    if (!_recorder.isRecording) {
+      final size = _repaintKey.currentContext?.size ?? Size.zero;
+      _recorder.start(size);
+      // Start from a known state so replay does not depend on the current one
+      _recorder.recordTool(controller.currentTool.value);
+      _recorder.recordBrushMode(controller.currentBrushMode.value);
+      _recorder.recordBrushSize(controller.brushSize.value);
+      _recorder.recordColor(controller.currentColor.value.value);
+      _recorder.recordOpacity(controller.toolOpacity.value);
+      _recorder.recordEraserMode(controller.eraserMode.value);
+      _recorder.recordLassoMode(controller.lassoMode.value);
+      _recorder.recordLayer(InputEventType.activeLayer,
+          index: controller.activeLayerIndex.value);
+      _recordView();
+      setState(() {});
+      return;
+    }
+
+    final session = _recorder.stop();
+    setState(() => _lastSession = session);
+    if (kIsWeb) return;
+    try {
+      final dir = await getApplicationDocumentsDirectory();
+      final file = File(p.join(dir.path, 'sessions',
+          'session-${DateTime.now().millisecondsSinceEpoch}.skis'));
+      await file.parent.create(recursive: true);
+      await file.writeAsBytes(session.toBytes());
+      Get.snackbar(
+        'Session Recorded',
+        '${session.strokeCount} strokes, ${session.events.length} events\n'
+            '${file.path}',
+        snackPosition: SnackPosition.BOTTOM,
+      );
+    } catch (e) {
+      debugPrint('Session save failed: $e');
+      Get.snackbar(
+        'Session Save Error',
+        'Failed to save input session: $e',
+        snackPosition: SnackPosition.BOTTOM,
+        backgroundColor: Colors.red,
+        colorText: Colors.white,
+      );
+    }
+  }
+
+  /// Replays [session] through the same pointer handlers as live input.
+  Future<void> _replaySession(InputSession session,
+      {ReplaySpeed speed = ReplaySpeed.recorded}) async {
+    _replayer?.cancel();
+    _cancelDrawing();
+    final replayer = InputReplayer(
+      session: session,
+      controller: controller,
+      onPointer: _dispatchPointer,
+      speed: speed,
+    );
+    setState(() => _replayer = replayer);
+    try {
+      await replayer.run();
+    } finally {
+      if (identical(_replayer, replayer)) {
+        _replayer = null;
+        if (mounted) setState(() {});
+      }
+    }
+  }
+
+  void _dispatchPointer(PointerEvent event) {
+    if (!mounted) return;
+    if (event is PointerDownEvent) {
+      _handlePointerDown(event);
+    } else if (event is PointerMoveEvent) {
+      _handlePointerMove(event);
+    } else if (event is PointerUpEvent) {
+      _handlePointerUp(event);
+    } else if (event is PointerCancelEvent) {
+      _handlePointerCancel(event);
+    }
+  }
+
   // Phase 3: Error recovery helper method
   void _cancelDrawing() {
     try {
@@ -409,6 +480,7 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
       _downPos = null;
       _cursorPos = null;
       _pointerCount = 0;
+      _cancelSelectionDrag();
 
       // Try to cancel current stroke safely
       if (controller.currentStroke != null) {
@@ -447,9 +519,277 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
     return Rect.fromLTRB(minX, minY, maxX, maxY).inflate(32); // padding
   }
 
-  // Interaction callbacks removed with InteractiveViewer
+  // Lasso mode: a drag that starts on the selection moves it, one that
+  // starts on its corner handle scales and rotates it about its centre, and
+  // any other drag draws a new lasso. A second pointer cancels the drag and
+  // leaves zoom and pan to the InteractiveViewer.
+  void _lassoPointerDown(Offset scenePos) {
+    _downPos = scenePos;
+    final bounds = controller.selectionBounds;
+    final handleReach =
+        SelectionPainter.handleRadius * 1.5 / controller.zoomScale;
+    if (bounds != null &&
+        (scenePos - bounds.bottomRight).distance <= handleReach) {
+      _selectionDrag = _SelectionDrag.scaleRotate;
+    } else if (bounds != null && bounds.contains(scenePos)) {
+      _selectionDrag = _SelectionDrag.move;
+    } else {
+      _selectionDrag = _SelectionDrag.lasso;
+      controller.beginLasso(scenePos);
+      return;
+    }
+    // Record before the stroke layer drops the selection, so it is never
+    // missing from a frame
+    _recordSelectionPicture();
+    controller.beginSelectionTransform();
+  }
+
+  void _lassoPointerMove(Offset scenePos) {
+    final down = _downPos;
+    if (down == null) return;
+    switch (_selectionDrag) {
+      case _SelectionDrag.lasso:
+        controller.extendLasso(scenePos);
+        break;
+      case _SelectionDrag.move:
+        controller.setSelectionTransform(offset: scenePos - down);
+        break;
+      case _SelectionDrag.scaleRotate:
+        final pivot = controller.selectionBounds!.center;
+        final from = down - pivot;
+        final to = scenePos - pivot;
+        if (from.distance == 0) break;
+        controller.setSelectionTransform(
+          scale: to.distance / from.distance,
+          rotation: to.direction - from.direction,
+        );
+        break;
+      case _SelectionDrag.none:
+        break;
+    }
+  }
+
+  void _lassoPointerUp() {
+    switch (_selectionDrag) {
+      case _SelectionDrag.lasso:
+        controller.endLasso();
+        break;
+      case _SelectionDrag.move:
+      case _SelectionDrag.scaleRotate:
+        controller.commitSelectionTransform();
+        _disposeSelectionPicture();
+        break;
+      case _SelectionDrag.none:
+        break;
+    }
+    _selectionDrag = _SelectionDrag.none;
+    _downPos = null;
+  }
+
+  void _cancelSelectionDrag() {
+    switch (_selectionDrag) {
+      case _SelectionDrag.lasso:
+        controller.clearSelection();
+        break;
+      case _SelectionDrag.move:
+      case _SelectionDrag.scaleRotate:
+        controller.cancelSelectionTransform();
+        _disposeSelectionPicture();
+        break;
+      case _SelectionDrag.none:
+        break;
+    }
+    _selectionDrag = _SelectionDrag.none;
+  }
+
+  void _recordSelectionPicture() {
+    _disposeSelectionPicture();
+    final size = _repaintKey.currentContext?.size;
+    if (size == null) return;
+    _selectionPicture = ImageTracker.picture(
+        SketchPainter.recordStrokes(controller.selection, size),
+        'DrawingCanvas.selection');
+  }
+
+  void _disposeSelectionPicture() {
+    _selectionPicture?.dispose();
+    _selectionPicture = null;
+  }
+
+  void _handlePointerDown(PointerDownEvent event) {
+    _recorder.recordPointer(event, _pointerCount);
+    // Phase 3: Error boundary for pointer down events
+    try {
+      if (kSketchLog) {
+        SketchLog.log('pointer', 'down', <String, Object?>{
+          'kind': event.kind.name,
+          'pointers': _pointerCount,
+        });
+      }
+      final newCount = (_pointerCount + 1).clamp(0, 10);
+      final scenePos =
+          controller.transformationController.toScene(event.localPosition);
+      final isStylus = event.kind == ui.PointerDeviceKind.stylus ||
+          event.kind == ui.PointerDeviceKind.invertedStylus;
+      final isMouse = event.kind == ui.PointerDeviceKind.mouse;
+      final inputAllowed =
+          !controller.stylusOnlyMode.value ? true : (isStylus || isMouse);
+
+      if (controller.lassoMode.value) {
+        if (newCount == 1 && inputAllowed) {
+          _lassoPointerDown(scenePos);
+        } else {
+          _cancelSelectionDrag();
+        }
+        _pointerCount = newCount;
+        setState(() {});
+        return;
+      }
+
+      if (newCount == 1 && inputAllowed) {
+        // Defer starting stroke until we see movement or a tap completes.
+        _downPos = scenePos;
+        _pendingTap = true;
+        _cursorPos = scenePos;
+      } else {
+        // Multi-touch: cancel any pending tap or drawing.
+        _pendingTap = false;
+        if (_isDrawing) {
+          _isDrawing = false;
+          controller.endStroke();
+          _cursorPos = null;
+        }
+      }
+      _pointerCount = newCount;
+      setState(() {});
+    } catch (e) {
+      debugPrint('Pointer down error: $e');
+      // Graceful recovery: reset drawing state
+      _cancelDrawing();
+    }
+  }
+
+  void _handlePointerMove(PointerMoveEvent event) {
+    _recorder.recordPointer(event, _pointerCount);
+    // Phase 3: Error boundary for pointer move events
+    try {
+      final isStylus = event.kind == ui.PointerDeviceKind.stylus ||
+          event.kind == ui.PointerDeviceKind.invertedStylus;
+      final isMouse = event.kind == ui.PointerDeviceKind.mouse;
+      final inputAllowed =
+          !controller.stylusOnlyMode.value ? true : (isStylus || isMouse);
+      if (controller.lassoMode.value) {
+        if (_pointerCount == 1 && inputAllowed) {
+          _lassoPointerMove(controller.transformationController
+              .toScene(event.localPosition));
+        }
+        return;
+      }
+      if (_pointerCount == 1 && inputAllowed) {
+        final scenePos =
+            controller.transformationController.toScene(event.localPosition);
+        // Extract stylus tilt data for enhanced drawing (available on supported devices)
+        final tiltX = event.orientation; // Stylus orientation/tilt
+        final tiltY = 0.0; // Flutter doesn't expose separate tiltY yet
+
+        if (!_isDrawing && _pendingTap && _downPos != null) {
+          final moved = (scenePos - _downPos!).distance;
+          // Adjust touch slop based on zoom level - at high zoom, use smaller slop in scene coordinates
+          final zoomScale =
+              controller.transformationController.value.getMaxScaleOnAxis();
+          final adjustedTouchSlop = _touchSlop / zoomScale;
+          if (moved >= adjustedTouchSlop) {
+            // Start drawing after surpassing touch slop.
+            _isDrawing = true;
+            _pendingTap = false;
+            HapticFeedback.lightImpact();
+            controller.startStroke(_downPos!, 1.0, tiltX: tiltX, tiltY: tiltY);
+            controller.addPoint(scenePos, 1.0, tiltX: tiltX, tiltY: tiltY);
+          }
+        } else if (_isDrawing) {
+          controller.addPoint(scenePos, 1.0, tiltX: tiltX, tiltY: tiltY);
+        }
+        _cursorPos = scenePos;
+        setState(() {});
+      }
+    } catch (e) {
+      debugPrint('Pointer move error: $e');
+      // Graceful recovery: maintain current state or cancel if critical error
+      if (_isDrawing) {
+        try {
+          controller.endStroke();
+        } catch (endError) {
+          debugPrint('Error ending stroke in move error recovery: $endError');
+        }
+        _cancelDrawing();
+      }
+    }
+  }
+
+  void _handlePointerUp(PointerUpEvent event) {
+    _recorder.recordPointer(event, _pointerCount);
+    // Phase 3: Error boundary for pointer up events
+    try {
+      if (kSketchLog) {
+        SketchLog.log('pointer', 'up', <String, Object?>{
+          'kind': event.kind.name,
+          'pointers': _pointerCount,
+        });
+      }
+      final isStylus = event.kind == ui.PointerDeviceKind.stylus ||
+          event.kind == ui.PointerDeviceKind.invertedStylus;
+      final isMouse = event.kind == ui.PointerDeviceKind.mouse;
+      final inputAllowed =
+          !controller.stylusOnlyMode.value ? true : (isStylus || isMouse);
+      if (controller.lassoMode.value) {
+        if (_pointerCount == 1) _lassoPointerUp();
+      } else if (_pointerCount == 1 && inputAllowed) {
+        if (_isDrawing) {
+          _isDrawing = false;
+          controller.endStroke();
+          _cursorPos = null;
+        } else if (_pendingTap && _downPos != null) {
+          // Treat as a dot tap if no multitouch occurred and no move beyond slop.
+          final tiltX = event.orientation;
+          final tiltY = 0.0;
+          controller.startStroke(_downPos!, 1.0, tiltX: tiltX, tiltY: tiltY);
+          controller.endStroke();
+          _cursorPos = null;
+        }
+        _pendingTap = false;
+        _downPos = null;
+      }
+      _pointerCount = (_pointerCount - 1).clamp(0, 10);
+      setState(() {});
+    } catch (e) {
+      debugPrint('Pointer up error: $e');
+      // Graceful recovery: ensure clean state
+      _cancelDrawing();
+    }
+  }
+
+  void _handlePointerCancel(PointerCancelEvent event) {
+    _recorder.recordPointer(event, _pointerCount);
+    // Phase 3: Error boundary for pointer cancel events
+    try {
+      if (kSketchLog) SketchLog.log('pointer', 'cancel');
+      _cancelSelectionDrag();
+      if (_isDrawing) {
+        _isDrawing = false;
+        controller.endStroke();
+        _cursorPos = null;
+      }
+      _pendingTap = false;
+      _downPos = null;
 
-  // Pointer handlers migrated to GestureDetector callbacks
+      _pointerCount = (_pointerCount - 1).clamp(0, 10);
+      setState(() {});
+    } catch (e) {
+      debugPrint('Pointer cancel error: $e');
+      // Graceful recovery: force clean state
+      _cancelDrawing();
+    }
+  }
 
   Widget _buildToolbar() {
     return Material(
@@ -475,10 +815,94 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
                       const SizedBox(width: 16),
                       // Color Picker Icon (Professional color palette access)
                       _buildColorPickerButton(controller),
+                      const SizedBox(width: 8),
+                      // Lasso selection: move, scale and rotate strokes
+                      Tooltip(
+                        message: 'Lasso Select',
+                        child: IconButton(
+                          key: const Key('lasso-button'),
+                          icon: Icon(
+                            Icons.highlight_alt,
+                            color: controller.lassoMode.value
+                                ? Colors.blue[600]
+                                : Colors.grey[700],
+                          ),
+                          onPressed: () => controller
+                              .setLassoMode(!controller.lassoMode.value),
+                        ),
+                      ),
+                      // Layers: add, remove, show/hide, opacity, blend mode
+                      Tooltip(
+                        message: 'Layers',
+                        child: IconButton(
+                          key: const Key('layers-button'),
+                          icon: Icon(
+                            Icons.layers,
+                            color: controller.layers.length > 1
+                                ? Colors.blue[600]
+                                : Colors.grey[700],
+                          ),
+                          onPressed: _showLayers,
+                        ),
+                      ),
                       const SizedBox(width: 16),
                       // Brush mode selector (shown only for Brush tool)
                       if (controller.currentTool.value == DrawingTool.brush)
                         _buildBrushModeSelector(controller),
+                      // Eraser mode selector (shown only for Eraser tool)
+                      if (controller.currentTool.value == DrawingTool.eraser)
+                        _buildEraserModeSelector(controller),
+                      const SizedBox(width: 16),
+                      // Performance overlay toggle (diagnostics)
+                      Tooltip(
+                        message: 'Performance Overlay',
+                        child: IconButton(
+                          key: const Key('perf-overlay-button'),
+                          icon: Icon(
+                            Icons.speed,
+                            color: controller.showPerfOverlay.value
+                                ? Colors.blue[600]
+                                : Colors.grey[700],
+                          ),
+                          onPressed: controller.togglePerfOverlay,
+                        ),
+                      ),
+                      // Input session recording and replay (diagnostics)
+                      Tooltip(
+                        message: _recorder.isRecording
+                            ? 'Stop Recording Session'
+                            : 'Record Input Session',
+                        child: IconButton(
+                          key: const Key('record-session-button'),
+                          icon: Icon(
+                            _recorder.isRecording
+                                ? Icons.stop_circle
+                                : Icons.fiber_manual_record,
+                            color: _recorder.isRecording
+                                ? Colors.red[600]
+                                : Colors.grey[700],
+                          ),
+                          onPressed:
+                              _replayer == null ? _toggleRecording : null,
+                        ),
+                      ),
+                      Tooltip(
+                        message: 'Replay Last Session',
+                        child: IconButton(
+                          key: const Key('replay-session-button'),
+                          icon: Icon(
+                            Icons.replay,
+                            color: _replayer != null
+                                ? Colors.blue[600]
+                                : Colors.grey[700],
+                          ),
+                          onPressed: _lastSession == null ||
+                                  _recorder.isRecording ||
+                                  _replayer != null
+                              ? null
+                              : () => _replaySession(_lastSession!),
+                        ),
+                      ),
                       const SizedBox(width: 16), // Extra space at the end
                     ],
                   ),
@@ -623,6 +1047,53 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
     );
   }
 
+  Widget _buildEraserModeSelector(SketchController controller) {
+    final current = controller.eraserMode.value;
+    return Semantics(
+      label: 'Eraser mode selector',
+      child: Container(
+        height: 40,
+        padding: const EdgeInsets.symmetric(horizontal: 8),
+        decoration: BoxDecoration(
+          color: Colors.grey[100],
+          borderRadius: BorderRadius.circular(20),
+          border: Border.all(color: Colors.grey[300]!),
+        ),
+        child: Row(children: [
+          Tooltip(
+            message: 'Erase Pixels',
+            child: ChoiceChip(
+              key: const Key('eraser-mode-pixel'),
+              label: const Text('Pixel'),
+              selected: current == EraserMode.pixel,
+              onSelected: (_) => controller.setEraserMode(EraserMode.pixel),
+            ),
+          ),
+          const SizedBox(width: 8),
+          Tooltip(
+            message: 'Split Strokes',
+            child: ChoiceChip(
+              key: const Key('eraser-mode-vector'),
+              label: const Text('Vector'),
+              selected: current == EraserMode.vector,
+              onSelected: (_) => controller.setEraserMode(EraserMode.vector),
+            ),
+          ),
+          const SizedBox(width: 8),
+          Tooltip(
+            message: 'Erase Whole Strokes',
+            child: ChoiceChip(
+              key: const Key('eraser-mode-object'),
+              label: const Text('Object'),
+              selected: current == EraserMode.object,
+              onSelected: (_) => controller.setEraserMode(EraserMode.object),
+            ),
+          ),
+        ]),
+      ),
+    );
+  }
+
   Widget _buildSegmentedButton(
     IconData icon,
     String tooltip,
@@ -750,14 +1221,7 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
                                 tooltip: 'Remove Image',
                                 key: const Key('remove-background-button'),
                                 color: Colors.red,
-                                onTap: () {
-                                  setState(() {
-                                    _backgroundImageData = null;
-                                  });
-                                  controller.setBackgroundImage(null);
-                                  controller.isImageVisible.value = false;
-                                  controller.update();
-                                },
+                                onTap: _removeBackgroundImage,
                               ),
                               _divider(),
                             ],
@@ -1528,9 +1992,203 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
     );
   }
 
+  void _showLayers() {
+    showModalBottomSheet(
+      context: context,
+      isScrollControlled: true,
+      backgroundColor: Colors.transparent,
+      builder: (context) => _buildLayersPanel(),
+    );
+  }
+
+  // Layer list, top layer first, with settings for the active layer
+  Widget _buildLayersPanel() {
+    return DraggableScrollableSheet(
+      initialChildSize: 0.6,
+      minChildSize: 0.4,
+      maxChildSize: 0.9,
+      builder: (context, scrollController) {
+        return Container(
+          decoration: const BoxDecoration(
+            color: Colors.white,
+            borderRadius: BorderRadius.vertical(top: Radius.circular(20)),
+          ),
+          child: GetBuilder<SketchController>(
+            builder: (controller) {
+              final layers = controller.layers;
+              final active = controller.activeLayerIndex.value;
+              return Column(
+                children: [
+                  // Handle bar
+                  Container(
+                    margin: const EdgeInsets.only(top: 12, bottom: 8),
+                    width: 40,
+                    height: 4,
+                    decoration: BoxDecoration(
+                      color: Colors.grey[300],
+                      borderRadius: BorderRadius.circular(2),
+                    ),
+                  ),
+                  // Header
+                  Padding(
+                    padding: const EdgeInsets.all(16),
+                    child: Row(
+                      children: [
+                        const Text(
+                          'Layers',
+                          style: TextStyle(
+                            fontSize: 20,
+                            fontWeight: FontWeight.w600,
+                          ),
+                        ),
+                        const Spacer(),
+                        IconButton(
+                          key: const Key('add-layer-button'),
+                          tooltip: 'Add Layer',
+                          onPressed: () {
+                            _recorder.recordLayer(InputEventType.addLayer);
+                            controller.addLayer();
+                          },
+                          icon: const Icon(Icons.add),
+                        ),
+                        IconButton(
+                          onPressed: () => Navigator.pop(context),
+                          icon: const Icon(Icons.close),
+                        ),
+                      ],
+                    ),
+                  ),
+                  Expanded(
+                    child: ListView(
+                      controller: scrollController,
+                      children: [
+                        for (int i = layers.length - 1; i >= 0; i--)
+                          _buildLayerTile(controller, i, i == active),
+                        Padding(
+                          padding: const EdgeInsets.all(16),
+                          child: Column(
+                            crossAxisAlignment: CrossAxisAlignment.start,
+                            children: [
+                              _buildModernSlider(
+                                'Layer Opacity',
+                                layers[active].opacity,
+                                0.0,
+                                1.0,
+                                (value) {
+                                  _recorder.recordLayer(
+                                      InputEventType.layerOpacity,
+                                      index: active,
+                                      value: value);
+                                  controller.setLayerOpacity(active, value);
+                                },
+                                Icons.opacity,
+                                sliderKey: const Key('layer-opacity-slider'),
+                                onChangeEnd: (_) =>
+                                    controller.endLayerOpacityChange(),
+                              ),
+                              const SizedBox(height: 16),
+                              Row(
+                                children: [
+                                  Icon(Icons.tune,
+                                      size: 20, color: Colors.grey[600]),
+                                  const SizedBox(width: 8),
+                                  const Text(
+                                    'Blend Mode',
+                                    style: TextStyle(
+                                      fontSize: 16,
+                                      fontWeight: FontWeight.w500,
+                                    ),
+                                  ),
+                                  const Spacer(),
+                                  DropdownButton<BlendMode>(
+                                    key: const Key('layer-blend-mode'),
+                                    value: layers[active].blendMode,
+                                    items: [
+                                      for (final mode
+                                          in SketchLayer.blendModes)
+                                        DropdownMenuItem(
+                                          value: mode,
+                                          child: Text(_blendModeLabel(mode)),
+                                        ),
+                                    ],
+                                    onChanged: (mode) {
+                                      if (mode == null) return;
+                                      _recorder.recordLayer(
+                                          InputEventType.layerBlendMode,
+                                          index: active,
+                                          value: mode.index.toDouble());
+                                      controller.setLayerBlendMode(
+                                          active, mode);
+                                    },
+                                  ),
+                                ],
+                              ),
+                            ],
+                          ),
+                        ),
+                      ],
+                    ),
+                  ),
+                ],
+              );
+            },
+          ),
+        );
+      },
+    );
+  }
+
+  Widget _buildLayerTile(
+      SketchController controller, int index, bool isActive) {
+    final layer = controller.layers[index];
+    return ListTile(
+      key: Key('layer-tile-${layer.id}'),
+      selected: isActive,
+      selectedTileColor: Colors.blue[50],
+      leading: IconButton(
+        key: Key('layer-visibility-${layer.id}'),
+        tooltip: layer.visible ? 'Hide Layer' : 'Show Layer',
+        icon: Icon(layer.visible ? Icons.visibility : Icons.visibility_off),
+        onPressed: () {
+          _recorder.recordLayer(InputEventType.layerVisible,
+              index: index, value: layer.visible ? 0.0 : 1.0);
+          controller.setLayerVisible(index, !layer.visible);
+        },
+      ),
+      title: Text(layer.name),
+      subtitle: Text('${layer.strokes.length} strokes · '
+          '${_blendModeLabel(layer.blendMode)} · '
+          '${(layer.opacity * 100).round()}%'),
+      trailing: IconButton(
+        key: Key('layer-delete-${layer.id}'),
+        tooltip: 'Delete Layer',
+        icon: const Icon(Icons.delete_outline),
+        onPressed: controller.layers.length > 1
+            ? () {
+                _recorder.recordLayer(InputEventType.removeLayer,
+                    index: index);
+                controller.removeLayer(index);
+              }
+            : null,
+      ),
+      onTap: () {
+        _recorder.recordLayer(InputEventType.activeLayer, index: index);
+        controller.setActiveLayer(index);
+      },
+    );
+  }
+
+  static String _blendModeLabel(BlendMode mode) {
+    if (mode == BlendMode.srcOver) return 'Normal';
+    final name = mode.name;
+    final words = name.replaceAllMapped(
+        RegExp('[A-Z]'), (match) => ' ${match.group(0)}');
+    return words[0].toUpperCase() + words.substring(1);
+  }
+
   Widget _buildModernSlider(String label, double value, double min, double max,
       Function(double) onChanged, IconData icon,
-      {Key? sliderKey, bool compact = false}) {
+      {Key? sliderKey, bool compact = false, Function(double)? onChangeEnd}) {
     return Column(
       crossAxisAlignment: CrossAxisAlignment.start,
       children: [
@@ -1583,6 +2241,7 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
             min: min,
             max: max,
             onChanged: onChanged,
+            onChangeEnd: onChangeEnd,
           ),
         ),
       ],
@@ -1823,12 +2482,7 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
                   Icons.close,
                   Colors.red,
                   () {
-                    setState(() {
-                      _backgroundImageData = null;
-                    });
-                    controller.setBackgroundImage(null);
-                    controller.isImageVisible.value = false;
-                    controller.update();
+                    _removeBackgroundImage();
                     Navigator.pop(context);
                   },
                   key: const Key('remove-background-button'),
@@ -1942,12 +2596,7 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
                   title: const Text('Remove Background'),
                   onTap: () {
                     Navigator.pop(context);
-                    setState(() {
-                      _backgroundImageData = null;
-                    });
-                    controller.setBackgroundImage(null);
-                    controller.isImageVisible.value = false;
-                    controller.update();
+                    _removeBackgroundImage();
                   },
                 ),
             ],
@@ -2004,14 +2653,32 @@ class _DrawingCanvasState extends State<DrawingCanvas> {
   }
 
   Future<void> _saveSketch() async {
+    final metricsClock = RunnerMetrics.enabled ? (Stopwatch()..start()) : null;
+    if (StallWatchdog.enabled) {
+      StallWatchdog.note(StrokeOp.export,
+          strokes: controller.strokes.length,
+          tool: controller.currentTool.value,
+          brushMode: controller.currentBrushMode.value);
+    }
     try {
       final boundary = _repaintKey.currentContext?.findRenderObject()
           as RenderRepaintBoundary?;
       if (boundary == null) return;
-      final image = await boundary.toImage(pixelRatio: 3.0);
-      final byteData = await image.toByteData(format: ui.ImageByteFormat.png);
+      final image = ImageTracker.image(
+          await boundary.toImage(pixelRatio: 3.0), 'DrawingCanvas.export');
+      final ByteData? byteData;
+      try {
+        byteData = await image.toByteData(format: ui.ImageByteFormat.png);
+      } finally {
+        image.dispose();
+      }
       if (byteData == null) return;
       final pngBytes = byteData.buffer.asUint8List();
+      if (metricsClock != null) {
+        RunnerMetrics.record(
+            MetricHistogram.exportUs, metricsClock.elapsedMicroseconds);
+        RunnerMetrics.add(MetricCounter.exports);
+      }
 
       // TODO: Persist via path_provider and show a snackbar with the path
       Get.snackbar(
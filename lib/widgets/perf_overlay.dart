@@ -0,0 +1,117 @@
+import 'package:flutter/material.dart';
+import 'package:flutter/scheduler.dart';
+import 'dart:async';
+import 'dart:ui' as ui;
+import '../controllers/sketch_controller.dart';
+import '../painters/sketch_painter.dart';
+import '../utils/frame_stats.dart';
+import '../utils/image_tracker.dart';
+import '../utils/memory_manager.dart';
+
+/// In-app performance readout, toggled from the canvas toolbar.
+///
+/// Shows rolling p50/p95/p99 build and raster times from [FrameTiming] next
+/// to the painter's work counters and the accounted memory. It refreshes
+/// twice a second instead of every frame so it stays out of its own numbers.
+/// Cache hit rates count from when the overlay was shown.
+/// Debug builds add the live image and picture counts from [ImageTracker].
+class PerfOverlay extends StatefulWidget {
+  final SketchController controller;
+  final ui.Image? backgroundImage;
+
+  const PerfOverlay({
+    super.key,
+    required this.controller,
+    this.backgroundImage,
+  });
+
+  @override
+  State<PerfOverlay> createState() => _PerfOverlayState();
+}
+
+class _PerfOverlayState extends State<PerfOverlay> {
+  final RollingFrameStats _frames = RollingFrameStats();
+  Timer? _refreshTimer;
+
+  @override
+  void initState() {
+    super.initState();
+    SketchPainter.stats.resetCacheCounters();
+    SchedulerBinding.instance.addTimingsCallback(_onTimings);
+    _refreshTimer = Timer.periodic(const Duration(milliseconds: 500), (_) {
+      if (mounted) setState(() {});
+    });
+  }
+
+  @override
+  void dispose() {
+    SchedulerBinding.instance.removeTimingsCallback(_onTimings);
+    _refreshTimer?.cancel();
+    super.dispose();
+  }
+
+  void _onTimings(List<FrameTiming> timings) {
+    for (final timing in timings) {
+      _frames.addTiming(timing);
+    }
+  }
+
+  String _ms(double v) => v.toStringAsFixed(1).padLeft(5);
+
+  String _percent(double rate) => '${(rate * 100).toStringAsFixed(0)}%';
+
+  String _bytes(int bytes) {
+    if (bytes >= 1024 * 1024) {
+      return '${(bytes / (1024 * 1024)).toStringAsFixed(1)} MB';
+    }
+    return '${(bytes / 1024).toStringAsFixed(1)} KB';
+  }
+
+  @override
+  Widget build(BuildContext context) {
+    final stats = SketchPainter.stats;
+    final memory = MemoryManager.accountedBytes(
+      widget.controller.allStrokes,
+      background: widget.backgroundImage,
+    );
+    final lines = <String>[
+      'frames ${_frames.sampleCount}',
+      'build  p50${_ms(_frames.buildMs(50))} '
+          'p95${_ms(_frames.buildMs(95))} '
+          'p99${_ms(_frames.buildMs(99))} ms',
+      'raster p50${_ms(_frames.rasterMs(50))} '
+          'p95${_ms(_frames.rasterMs(95))} '
+          'p99${_ms(_frames.rasterMs(99))} ms',
+      'live points ${stats.livePoints}',
+      'strokes ${stats.visibleStrokes} visible / '
+          '${stats.culledStrokes} culled',
+      'pen batches ${stats.penBatches}',
+      'cached layers ${stats.cachedLayers}',
+      'cache hits bounds ${_percent(stats.boundsCacheHitRate)} '
+          'paint ${_percent(stats.paintCacheHitRate)}',
+      'memory ${_bytes(memory)} accounted',
+      if (kDebugMode)
+        'live images ${ImageTracker.liveImages} '
+            '(${_bytes(ImageTracker.liveImageBytes)}) '
+            'pictures ${ImageTracker.livePictures}',
+    ];
+
+    return Container(
+      key: const Key('perf-overlay'),
+      padding: const EdgeInsets.symmetric(horizontal: 10, vertical: 8),
+      decoration: BoxDecoration(
+        color: Colors.black.withOpacity(0.72),
+        borderRadius: BorderRadius.circular(10),
+      ),
+      child: Text(
+        lines.join('\n'),
+        style: const TextStyle(
+          color: Colors.white,
+          fontSize: 11,
+          fontFamily: 'monospace',
+          height: 1.35,
+        ),
+      ),
+    );
+  }
+}
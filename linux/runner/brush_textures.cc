@@ -0,0 +1,56 @@
+#include "brush_textures.h"
+
+#include <gio/gio.h>
+
+// Resource paths, indexed like the Dart BrushTexture enum.
+static const char* const kTexturePaths[] = {
+    "/dev/sketcher/brush_textures/pencil_paper.r8",
+    "/dev/sketcher/brush_textures/charcoal_grain.r8",
+    "/dev/sketcher/brush_textures/pastel_grain.r8",
+};
+static constexpr int32_t kTextureCount =
+    sizeof(kTexturePaths) / sizeof(kTexturePaths[0]);
+
+// Uncompressed resources are returned as GBytes over the static data the
+// resource compiler embedded in the binary, so nothing is decoded or copied.
+// The references are kept so the pointers stay valid.
+static GBytes* textures[kTextureCount];
+G_LOCK_DEFINE_STATIC(textures);
+
+static GBytes* lookup_texture(int32_t id) {
+  if (id < 0 || id >= kTextureCount) {
+    return nullptr;
+  }
+  G_LOCK(textures);
+  if (textures[id] == nullptr) {
+    g_autoptr(GError) error = nullptr;
+    textures[id] = g_resources_lookup_data(
+        kTexturePaths[id], G_RESOURCE_LOOKUP_FLAGS_NONE, &error);
+    if (textures[id] == nullptr) {
+      g_warning("Brush texture %d unavailable: %s", id, error->message);
+    }
+  }
+  GBytes* bytes = textures[id];
+  G_UNLOCK(textures);
+  return bytes;
+}
+
+const uint8_t* sketcher_brush_texture_data(int32_t id) {
+  GBytes* bytes = lookup_texture(id);
+  return bytes == nullptr
+             ? nullptr
+             : static_cast<const uint8_t*>(g_bytes_get_data(bytes, nullptr));
+}
+
+int32_t sketcher_brush_texture_edge(int32_t id) {
+  GBytes* bytes = lookup_texture(id);
+  if (bytes == nullptr) {
+    return 0;
+  }
+  const gsize size = g_bytes_get_size(bytes);
+  int32_t edge = 0;
+  while (static_cast<gsize>(edge + 1) * (edge + 1) <= size) {
+    edge++;
+  }
+  return static_cast<gsize>(edge) * edge == size ? edge : 0;
+}
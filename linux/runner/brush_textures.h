@@ -0,0 +1,28 @@
+#ifndef FLUTTER_BRUSH_TEXTURES_H_
+#define FLUTTER_BRUSH_TEXTURES_H_
+
+#include <stdint.h>
+
+// FFI entry points for lib/utils/brush_textures_native.dart. Exported from
+// the executable so DynamicLibrary.executable() can find them.
+#define SKETCHER_EXPORT extern "C" __attribute__((visibility("default")))
+
+/**
+ * sketcher_brush_texture_data:
+ * @id: a BrushTexture index.
+ *
+ * Returns: the texture's alpha bytes inside the binary's read-only data, or
+ * %NULL for an unknown @id. Valid for the life of the process.
+ */
+SKETCHER_EXPORT const uint8_t* sketcher_brush_texture_data(int32_t id);
+
+/**
+ * sketcher_brush_texture_edge:
+ * @id: a BrushTexture index.
+ *
+ * Returns: the edge length in pixels of the square texture, or 0 for an
+ * unknown @id.
+ */
+SKETCHER_EXPORT int32_t sketcher_brush_texture_edge(int32_t id);
+
+#endif  // FLUTTER_BRUSH_TEXTURES_H_
@@ -0,0 +1,252 @@
+// Headless batch renderer: renders a directory of sketch documents to PNG
+// through the app's own Dart code (SketchPainter), without showing a window.
+//
+//   flutter_project_headless --input=<dir> [--output=<dir>]
+//                            [--thumbnail=<px>] [--jobs=<n>]
+//                            [--timeout=<seconds>]
+//
+// The coordinator process spawns --jobs workers of this same executable,
+// each running one Flutter engine on its shard of the input (--shard=i/n),
+// and exits non-zero if any worker failed. Workers report back from Dart
+// over the "sketcher/headless" channel: "started" once the isolate runs,
+// then "finished" with the exit status. A worker that does not hear
+// "started" within kStartupTimeoutSeconds (the engine failed to start) or
+// "finished" within --timeout gives up and fails, so one stuck engine
+// cannot hang the batch.
+
+#include <flutter_linux/flutter_linux.h>
+#include <gtk/gtk.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+
+static constexpr char kHeadlessChannel[] = "sketcher/headless";
+static constexpr guint kStartupTimeoutSeconds = 60;
+static constexpr gint kDefaultTimeoutSeconds = 600;
+
+struct HeadlessOptions {
+  gchar* input_dir = nullptr;
+  gchar* output_dir = nullptr;
+  gint thumbnail = 0;
+  gint jobs = 0;
+  gint timeout = kDefaultTimeoutSeconds;  // 0 waits forever.
+  gchar* shard = nullptr;  // Set on workers only.
+};
+
+struct WorkerState {
+  int status = 1;
+  guint startup_source = 0;  // Pending until Dart says "started".
+  guint timeout_source = 0;
+};
+
+struct CoordinatorState {
+  GMainLoop* loop = nullptr;
+  int remaining = 0;
+  int failed = 0;
+};
+
+// Handles "started" and "finished" from the Dart side of a worker.
+static void headless_method_call_cb(FlMethodChannel* channel,
+                                    FlMethodCall* method_call,
+                                    gpointer user_data) {
+  WorkerState* state = static_cast<WorkerState*>(user_data);
+  const gchar* method = fl_method_call_get_name(method_call);
+  if (strcmp(method, "started") == 0) {
+    g_clear_handle_id(&state->startup_source, g_source_remove);
+    g_autoptr(FlMethodResponse) response =
+        FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+    fl_method_call_respond(method_call, response, nullptr);
+    return;
+  }
+  if (strcmp(method, "finished") != 0) {
+    g_autoptr(FlMethodResponse) response =
+        FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+    fl_method_call_respond(method_call, response, nullptr);
+    return;
+  }
+
+  FlValue* args = fl_method_call_get_args(method_call);
+  state->status = args != nullptr &&
+                          fl_value_get_type(args) == FL_VALUE_TYPE_INT
+                      ? static_cast<int>(fl_value_get_int(args))
+                      : 1;
+  g_autoptr(FlMethodResponse) response =
+      FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  fl_method_call_respond(method_call, response, nullptr);
+  gtk_main_quit();
+}
+
+// Fails the worker if the Dart isolate never came up.
+static gboolean worker_startup_timeout_cb(gpointer user_data) {
+  WorkerState* state = static_cast<WorkerState*>(user_data);
+  state->startup_source = 0;
+  g_printerr("Headless worker %d: engine did not start within %us\n",
+             getpid(), kStartupTimeoutSeconds);
+  state->status = 1;
+  gtk_main_quit();
+  return G_SOURCE_REMOVE;
+}
+
+// Fails the worker if its shard has not finished in time.
+static gboolean worker_timeout_cb(gpointer user_data) {
+  WorkerState* state = static_cast<WorkerState*>(user_data);
+  state->timeout_source = 0;
+  g_printerr("Headless worker %d timed out\n", getpid());
+  state->status = 1;
+  gtk_main_quit();
+  return G_SOURCE_REMOVE;
+}
+
+// Runs one engine over one shard of the input.
+static int run_worker(const HeadlessOptions* options) {
+  gtk_init(nullptr, nullptr);
+
+  g_autofree gchar* input_arg =
+      g_strdup_printf("--input=%s", options->input_dir);
+  g_autofree gchar* output_arg =
+      g_strdup_printf("--output=%s", options->output_dir);
+  g_autofree gchar* thumbnail_arg =
+      g_strdup_printf("--thumbnail=%d", options->thumbnail);
+  g_autofree gchar* shard_arg = g_strdup_printf("--shard=%s", options->shard);
+  gchar* dart_args[] = {const_cast<gchar*>("--headless-render"), input_arg,
+                        output_arg, thumbnail_arg, shard_arg, nullptr};
+
+  g_autoptr(FlDartProject) project = fl_dart_project_new();
+  fl_dart_project_set_dart_entrypoint_arguments(project, dart_args);
+
+  // flutter_linux only starts an engine when its view is realized, so the
+  // view goes into a toplevel that is realized but never mapped. Nothing is
+  // shown, though a display connection (e.g. Xvfb) is still needed for GL.
+  GtkWidget* window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+  FlView* view = fl_view_new(project);
+  gtk_container_add(GTK_CONTAINER(window), GTK_WIDGET(view));
+
+  WorkerState state;
+  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+  g_autoptr(FlMethodChannel) channel = fl_method_channel_new(
+      fl_engine_get_binary_messenger(fl_view_get_engine(view)),
+      kHeadlessChannel, FL_METHOD_CODEC(codec));
+  fl_method_channel_set_method_call_handler(channel, headless_method_call_cb,
+                                            &state, nullptr);
+
+  gtk_widget_realize(GTK_WIDGET(view));
+  state.startup_source = g_timeout_add_seconds(
+      kStartupTimeoutSeconds, worker_startup_timeout_cb, &state);
+  if (options->timeout > 0) {
+    state.timeout_source =
+        g_timeout_add_seconds(options->timeout, worker_timeout_cb, &state);
+  }
+  gtk_main();
+
+  // A watchdog that did not fire must not outlive the state it points at
+  g_clear_handle_id(&state.startup_source, g_source_remove);
+  g_clear_handle_id(&state.timeout_source, g_source_remove);
+  gtk_widget_destroy(window);
+  return state.status;
+}
+
+static void worker_exited_cb(GPid pid, gint wait_status, gpointer user_data) {
+  CoordinatorState* state = static_cast<CoordinatorState*>(user_data);
+  if (!WIFEXITED(wait_status) || WEXITSTATUS(wait_status) != 0) {
+    g_printerr("Headless worker %d failed\n", pid);
+    state->failed++;
+  }
+  g_spawn_close_pid(pid);
+  if (--state->remaining == 0) {
+    g_main_loop_quit(state->loop);
+  }
+}
+
+// Spawns one worker process per job and waits for all of them.
+static int run_coordinator(const HeadlessOptions* options) {
+  g_autoptr(GError) error = nullptr;
+  g_autofree gchar* self_path = g_file_read_link("/proc/self/exe", &error);
+  if (self_path == nullptr) {
+    g_printerr("Cannot locate executable: %s\n", error->message);
+    return 1;
+  }
+
+  const int jobs = options->jobs > 0
+                       ? options->jobs
+                       : static_cast<int>(g_get_num_processors());
+  g_autoptr(GMainLoop) loop = g_main_loop_new(nullptr, FALSE);
+  CoordinatorState state;
+  state.loop = loop;
+
+  g_autofree gchar* input_arg =
+      g_strdup_printf("--input=%s", options->input_dir);
+  g_autofree gchar* output_arg =
+      g_strdup_printf("--output=%s", options->output_dir);
+  g_autofree gchar* thumbnail_arg =
+      g_strdup_printf("--thumbnail=%d", options->thumbnail);
+  g_autofree gchar* timeout_arg =
+      g_strdup_printf("--timeout=%d", options->timeout);
+  for (int i = 0; i < jobs; i++) {
+    g_autofree gchar* shard_arg = g_strdup_printf("--shard=%d/%d", i, jobs);
+    gchar* argv[] = {self_path,     input_arg, output_arg, thumbnail_arg,
+                     timeout_arg,   shard_arg, nullptr};
+    GPid pid;
+    g_autoptr(GError) spawn_error = nullptr;
+    if (!g_spawn_async(nullptr, argv, nullptr, G_SPAWN_DO_NOT_REAP_CHILD,
+                       nullptr, nullptr, &pid, &spawn_error)) {
+      g_printerr("Failed to start headless worker: %s\n",
+                 spawn_error->message);
+      state.failed++;
+      continue;
+    }
+    state.remaining++;
+    g_child_watch_add(pid, worker_exited_cb, &state);
+  }
+
+  if (state.remaining > 0) {
+    g_main_loop_run(loop);
+  }
+  return state.failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+  HeadlessOptions options;
+  GOptionEntry entries[] = {
+      {"input", 0, 0, G_OPTION_ARG_FILENAME, &options.input_dir,
+       "Directory of sketch documents (*.json)", "DIR"},
+      {"output", 0, 0, G_OPTION_ARG_FILENAME, &options.output_dir,
+       "Directory for the PNG files (default: input)", "DIR"},
+      {"thumbnail", 0, 0, G_OPTION_ARG_INT, &options.thumbnail,
+       "Scale the longest edge down to PX pixels", "PX"},
+      {"jobs", 0, 0, G_OPTION_ARG_INT, &options.jobs,
+       "Engine instances to run in parallel (default: CPU count)", "N"},
+      {"timeout", 0, 0, G_OPTION_ARG_INT, &options.timeout,
+       "Fail a worker that has not finished after SECONDS (default: 600, "
+       "0: no limit)",
+       "SECONDS"},
+      {"shard", 0, G_OPTION_FLAG_HIDDEN, G_OPTION_ARG_STRING, &options.shard,
+       nullptr, nullptr},
+      {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr},
+  };
+
+  g_autoptr(GOptionContext) context =
+      g_option_context_new("- render sketch documents to PNG");
+  g_option_context_add_main_entries(context, entries, nullptr);
+  g_autoptr(GError) error = nullptr;
+  if (!g_option_context_parse(context, &argc, &argv, &error)) {
+    g_printerr("%s\n", error->message);
+    return 2;
+  }
+  if (options.input_dir == nullptr ||
+      !g_file_test(options.input_dir, G_FILE_TEST_IS_DIR)) {
+    g_printerr("--input must name a directory of sketch documents\n");
+    return 2;
+  }
+  if (options.output_dir == nullptr) {
+    options.output_dir = g_strdup(options.input_dir);
+  }
+
+  int status = options.shard != nullptr ? run_worker(&options)
+                                        : run_coordinator(&options);
+
+  g_free(options.input_dir);
+  g_free(options.output_dir);
+  g_free(options.shard);
+  return status;
+}
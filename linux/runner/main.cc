@@ -1,6 +1,10 @@
 #include "my_application.h"
+#include "startup_trace.h"
 
 int main(int argc, char** argv) {
+  startup_trace_mark("main");
   g_autoptr(MyApplication) app = my_application_new();
-  return g_application_run(G_APPLICATION(app), argc, argv);
+  int status = g_application_run(G_APPLICATION(app), argc, argv);
+  // A --benchmark run reports its result through the application.
+  return status != 0 ? status : my_application_get_exit_code(app);
 }
@@ -0,0 +1,213 @@
+#include "metrics.h"
+
+#include <glib-unix.h>
+#include <glib.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+// 8 sub-buckets per power of two; values below 8 get a bucket each. Samples
+// up to 2^40 (12.7 days in microseconds) are resolved, larger ones clamp.
+constexpr int kSubBucketBits = 3;
+constexpr int kSubBuckets = 1 << kSubBucketBits;
+constexpr int kMaxExponent = 40;
+constexpr int kBucketCount =
+    (kMaxExponent - kSubBucketBits + 1) * kSubBuckets + kSubBuckets;
+
+struct Histogram {
+  std::atomic<int64_t> count;
+  std::atomic<int64_t> sum;
+  std::atomic<int64_t> max;
+  std::atomic<int64_t> buckets[kBucketCount];
+};
+
+struct MetricsRegion {
+  std::atomic<int64_t> counters[kMetricCounterCount];
+  std::atomic<int64_t> gauges[kMetricGaugeCount];
+  Histogram histograms[kMetricHistogramCount];
+};
+
+// Zero-initialized static storage; no allocation, nothing to set up.
+MetricsRegion region;
+
+const char* const kCounterNames[] = {
+    "frames",
+    "strokes_committed",
+    "paint_cache_hits",
+    "paint_cache_misses",
+    "exports",
+    "input_events",
+    "ui_stalls",
+};
+const char* const kGaugeNames[] = {
+    "stroke_count",
+    "cached_image_bytes",
+    "rss_bytes",
+};
+const char* const kHistogramNames[] = {
+    "frame_build_us",
+    "frame_raster_us",
+    "end_stroke_us",
+    "export_us",
+    "ui_stall_us",
+};
+
+static_assert(sizeof(kCounterNames) / sizeof(kCounterNames[0]) ==
+                  kMetricCounterCount,
+              "every counter needs a name");
+static_assert(sizeof(kGaugeNames) / sizeof(kGaugeNames[0]) ==
+                  kMetricGaugeCount,
+              "every gauge needs a name");
+static_assert(sizeof(kHistogramNames) / sizeof(kHistogramNames[0]) ==
+                  kMetricHistogramCount,
+              "every histogram needs a name");
+
+int bucket_for(int64_t value) {
+  if (value < kSubBuckets) {
+    return static_cast<int>(value);
+  }
+  int exponent = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+  if (exponent > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  int sub = static_cast<int>(value >> (exponent - kSubBucketBits)) &
+            (kSubBuckets - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+// Upper bound of the values that land in @bucket.
+int64_t bucket_limit(int bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  int exponent = bucket / kSubBuckets - 1 + kSubBucketBits;
+  int64_t sub = bucket % kSubBuckets;
+  int shift = exponent - kSubBucketBits;
+  return ((kSubBuckets + sub + 1) << shift) - 1;
+}
+
+int64_t percentile(const Histogram& histogram, int64_t count,
+                   double percent) {
+  int64_t rank = static_cast<int64_t>(count * percent / 100.0 + 0.5);
+  if (rank < 1) {
+    rank = 1;
+  }
+  int64_t seen = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    seen += histogram.buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return bucket_limit(i);
+    }
+  }
+  return histogram.max.load(std::memory_order_relaxed);
+}
+
+int64_t current_rss_bytes() {
+  g_autofree gchar* statm = nullptr;
+  if (!g_file_get_contents("/proc/self/statm", &statm, nullptr, nullptr)) {
+    return 0;
+  }
+  long long pages = 0;
+  if (sscanf(statm, "%*lld %lld", &pages) != 1) {
+    return 0;
+  }
+  return pages * sysconf(_SC_PAGESIZE);
+}
+
+gboolean dump_signal_cb(gpointer user_data) {
+  metrics_dump();
+  return G_SOURCE_CONTINUE;
+}
+
+}  // namespace
+
+void sketcher_metric_add(int32_t id, int64_t delta) {
+  if (id < 0 || id >= kMetricCounterCount) {
+    return;
+  }
+  region.counters[id].fetch_add(delta, std::memory_order_relaxed);
+}
+
+void sketcher_metric_set(int32_t id, int64_t value) {
+  if (id < 0 || id >= kMetricGaugeCount) {
+    return;
+  }
+  region.gauges[id].store(value, std::memory_order_relaxed);
+}
+
+void sketcher_metric_record(int32_t id, int64_t value) {
+  if (id < 0 || id >= kMetricHistogramCount) {
+    return;
+  }
+  if (value < 0) {
+    value = 0;
+  }
+  Histogram& histogram = region.histograms[id];
+  histogram.buckets[bucket_for(value)].fetch_add(1,
+                                                 std::memory_order_relaxed);
+  histogram.count.fetch_add(1, std::memory_order_relaxed);
+  histogram.sum.fetch_add(value, std::memory_order_relaxed);
+  int64_t max = histogram.max.load(std::memory_order_relaxed);
+  while (value > max && !histogram.max.compare_exchange_weak(
+                            max, value, std::memory_order_relaxed)) {
+  }
+}
+
+int64_t metrics_gauge(int32_t id) {
+  if (id < 0 || id >= kMetricGaugeCount) {
+    return 0;
+  }
+  return region.gauges[id].load(std::memory_order_relaxed);
+}
+
+int64_t metrics_sample_rss() {
+  int64_t rss = current_rss_bytes();
+  sketcher_metric_set(kMetricRssBytes, rss);
+  return rss;
+}
+
+void metrics_dump() {
+  metrics_sample_rss();
+
+  g_autoptr(GString) out = g_string_new("Metrics:\n");
+  for (int i = 0; i < kMetricCounterCount; i++) {
+    g_string_append_printf(
+        out, "  %-22s %" G_GINT64_FORMAT "\n", kCounterNames[i],
+        static_cast<gint64>(
+            region.counters[i].load(std::memory_order_relaxed)));
+  }
+  for (int i = 0; i < kMetricGaugeCount; i++) {
+    g_string_append_printf(
+        out, "  %-22s %" G_GINT64_FORMAT "\n", kGaugeNames[i],
+        static_cast<gint64>(region.gauges[i].load(std::memory_order_relaxed)));
+  }
+  for (int i = 0; i < kMetricHistogramCount; i++) {
+    const Histogram& histogram = region.histograms[i];
+    int64_t count = histogram.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      g_string_append_printf(out, "  %-22s no samples\n", kHistogramNames[i]);
+      continue;
+    }
+    g_string_append_printf(
+        out,
+        "  %-22s n=%" G_GINT64_FORMAT " mean=%" G_GINT64_FORMAT
+        " p50=%" G_GINT64_FORMAT " p90=%" G_GINT64_FORMAT
+        " p99=%" G_GINT64_FORMAT " max=%" G_GINT64_FORMAT "\n",
+        kHistogramNames[i], static_cast<gint64>(count),
+        static_cast<gint64>(
+            histogram.sum.load(std::memory_order_relaxed) / count),
+        static_cast<gint64>(percentile(histogram, count, 50)),
+        static_cast<gint64>(percentile(histogram, count, 90)),
+        static_cast<gint64>(percentile(histogram, count, 99)),
+        static_cast<gint64>(histogram.max.load(std::memory_order_relaxed)));
+  }
+  g_printerr("%s", out->str);
+}
+
+void metrics_install_dump_handler() {
+  g_unix_signal_add(SIGUSR1, dump_signal_cb, nullptr);
+}
@@ -0,0 +1,100 @@
+#ifndef FLUTTER_METRICS_H_
+#define FLUTTER_METRICS_H_
+
+#include <stdint.h>
+
+// Process-wide metrics: counters, gauges and latency histograms in one
+// statically allocated region of atomics. Updates are single relaxed atomic
+// operations and safe from any thread, native or Dart (through FFI).
+//
+// Ids are indices into fixed tables and must match the enums in
+// lib/utils/runner_metrics.dart.
+
+#define SKETCHER_METRICS_EXPORT \
+  extern "C" __attribute__((visibility("default")))
+
+enum MetricCounter : int32_t {
+  kMetricFrames,
+  kMetricStrokesCommitted,
+  kMetricPaintCacheHits,
+  kMetricPaintCacheMisses,
+  kMetricExports,
+  kMetricInputEvents,
+  kMetricUiStalls,
+  kMetricCounterCount,
+};
+
+enum MetricGauge : int32_t {
+  kMetricStrokeCount,
+  kMetricCachedImageBytes,
+  kMetricRssBytes,
+  kMetricGaugeCount,
+};
+
+enum MetricHistogram : int32_t {
+  kMetricFrameBuildUs,
+  kMetricFrameRasterUs,
+  kMetricEndStrokeUs,
+  kMetricExportUs,
+  kMetricUiStallUs,
+  kMetricHistogramCount,
+};
+
+/**
+ * sketcher_metric_add:
+ * @id: a #MetricCounter.
+ * @delta: amount to add.
+ */
+SKETCHER_METRICS_EXPORT void sketcher_metric_add(int32_t id, int64_t delta);
+
+/**
+ * sketcher_metric_set:
+ * @id: a #MetricGauge.
+ * @value: the new value.
+ */
+SKETCHER_METRICS_EXPORT void sketcher_metric_set(int32_t id, int64_t value);
+
+/**
+ * sketcher_metric_record:
+ * @id: a #MetricHistogram.
+ * @value: a sample, normally in microseconds; negative samples count as 0.
+ *
+ * Histograms are log-linear (HDR style): 8 sub-buckets per power of two,
+ * so any reported percentile is within 12.5% of the true value.
+ */
+SKETCHER_METRICS_EXPORT void sketcher_metric_record(int32_t id,
+                                                    int64_t value);
+
+/**
+ * metrics_gauge:
+ * @id: a #MetricGauge.
+ *
+ * Returns: the gauge's current value.
+ */
+int64_t metrics_gauge(int32_t id);
+
+/**
+ * metrics_sample_rss:
+ *
+ * Reads the resident set size into the rss_bytes gauge.
+ *
+ * Returns: the RSS in bytes, or 0 if it could not be read.
+ */
+int64_t metrics_sample_rss();
+
+/**
+ * metrics_dump:
+ *
+ * Prints every metric, with histogram percentiles, to stderr.
+ */
+void metrics_dump();
+
+/**
+ * metrics_install_dump_handler:
+ *
+ * Dumps the metrics whenever the process receives SIGUSR1. The dump runs on
+ * the main loop, not in signal context.
+ */
+void metrics_install_dump_handler();
+
+#endif  // FLUTTER_METRICS_H_
@@ -4,19 +4,177 @@
 #ifdef GDK_WINDOWING_X11
 #include <gdk/gdkx.h>
 #endif
+#include <sys/resource.h>
+
+#include <cstring>
 
 #include "flutter/generated_plugin_registrant.h"
+#include "metrics.h"
+#include "startup_trace.h"
+#include "watchdog.h"
+
+// Channel the Dart side uses to report the end of a --benchmark run.
+static constexpr char kBenchmarkChannel[] = "sketcher/benchmark";
+static constexpr char kBenchmarkArg[] = "--benchmark=";
+static constexpr char kBenchmarkOutArg[] = "--benchmark-out=";
+// Keeps the window hidden until the first frame and registers plugins after
+// it, taking both off the cold start path.
+static constexpr char kFastStartupArg[] = "--fast-startup";
+// Channel the Dart side uses to add its own marks to the startup trace.
+static constexpr char kStartupChannel[] = "sketcher/startup";
+// Makes this a unique application: opening documents from a second launch
+// forwards them to the running process over kDocumentsChannel.
+static constexpr char kSingleInstanceArg[] = "--single-instance";
+static constexpr char kDocumentsChannel[] = "sketcher/documents";
+// How long the UI thread may go without a heartbeat before the watchdog logs
+// a stall; 0 turns the watchdog off.
+static constexpr char kWatchdogArg[] = "--watchdog-ms=";
+static constexpr gint kDefaultWatchdogMs = 100;
 
 struct _MyApplication {
   GtkApplication parent_instance;
   char** dart_entrypoint_arguments;
+  // Set by --benchmark=<session>; the Dart side replays the session and
+  // reports a status over kBenchmarkChannel, which becomes the exit code.
+  gboolean benchmark_mode;
+  int exit_code;
+  FlMethodChannel* benchmark_channel;
+  FlMethodChannel* startup_channel;
+  gboolean fast_startup;
+  FlMethodChannel* documents_channel;
+  // Paths to open, held until the Dart side reports "ready".
+  GPtrArray* pending_documents;
+  gboolean documents_ready;
+  gint watchdog_ms;
 };
 
 G_DEFINE_TYPE(MyApplication, my_application, GTK_TYPE_APPLICATION)
 
+// Handles "finished" from the Dart benchmark driver: records the status and
+// quits the application.
+static void benchmark_method_call_cb(FlMethodChannel* channel,
+                                     FlMethodCall* method_call,
+                                     gpointer user_data) {
+  MyApplication* self = MY_APPLICATION(user_data);
+  const gchar* method = fl_method_call_get_name(method_call);
+
+  if (strcmp(method, "finished") != 0) {
+    g_autoptr(FlMethodResponse) response =
+        FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+    fl_method_call_respond(method_call, response, nullptr);
+    return;
+  }
+
+  FlValue* args = fl_method_call_get_args(method_call);
+  self->exit_code = args != nullptr &&
+                            fl_value_get_type(args) == FL_VALUE_TYPE_INT
+                        ? static_cast<int>(fl_value_get_int(args))
+                        : 1;
+  g_autoptr(FlMethodResponse) response =
+      FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  fl_method_call_respond(method_call, response, nullptr);
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    g_message("Benchmark finished with status %d, peak RSS %ld KiB",
+              self->exit_code, usage.ru_maxrss);
+  }
+  g_application_quit(G_APPLICATION(self));
+}
+
+// Handles "mark" from the Dart side: {"name": String, "ts": int}, where ts is
+// Timeline.now. The Dart VM and g_get_monotonic_time() both read
+// CLOCK_MONOTONIC on Linux, so the marks share one timebase.
+static void startup_method_call_cb(FlMethodChannel* channel,
+                                   FlMethodCall* method_call,
+                                   gpointer user_data) {
+  FlValue* args = fl_method_call_get_args(method_call);
+  if (strcmp(fl_method_call_get_name(method_call), "mark") != 0 ||
+      args == nullptr || fl_value_get_type(args) != FL_VALUE_TYPE_MAP) {
+    g_autoptr(FlMethodResponse) response =
+        FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+    fl_method_call_respond(method_call, response, nullptr);
+    return;
+  }
+
+  FlValue* name = fl_value_lookup_string(args, "name");
+  FlValue* ts = fl_value_lookup_string(args, "ts");
+  if (name != nullptr && fl_value_get_type(name) == FL_VALUE_TYPE_STRING) {
+    // Fall back to the arrival time if the clocks ever disagree.
+    gint64 now = g_get_monotonic_time();
+    gint64 micros = ts != nullptr && fl_value_get_type(ts) == FL_VALUE_TYPE_INT
+                        ? fl_value_get_int(ts)
+                        : now;
+    if (micros <= 0 || micros > now) {
+      micros = now;
+    }
+    startup_trace_mark_at(fl_value_get_string(name), "dart", micros);
+    startup_trace_write(FALSE);
+  }
+  g_autoptr(FlMethodResponse) response =
+      FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  fl_method_call_respond(method_call, response, nullptr);
+}
+
+static void first_frame_cb(FlView* view, gpointer user_data) {
+  MyApplication* self = MY_APPLICATION(user_data);
+  startup_trace_mark("first_frame");
+  if (self->fast_startup) {
+    // The frame is ready, so the window maps with content: no blank flash
+    // and a single layout pass. No plugin is used before the first frame.
+    gtk_widget_show(gtk_widget_get_toplevel(GTK_WIDGET(view)));
+    fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+    startup_trace_mark("fl_register_plugins");
+  }
+  startup_trace_write(FALSE);
+}
+
+// Sends pending document paths to the Dart side once it is listening.
+static void flush_documents(MyApplication* self) {
+  if (!self->documents_ready || self->documents_channel == nullptr) {
+    return;
+  }
+  for (guint i = 0; i < self->pending_documents->len; i++) {
+    const gchar* path = static_cast<const gchar*>(
+        g_ptr_array_index(self->pending_documents, i));
+    g_autoptr(FlValue) args = fl_value_new_string(path);
+    fl_method_channel_invoke_method(self->documents_channel, "open", args,
+                                    nullptr, nullptr, nullptr);
+  }
+  g_ptr_array_set_size(self->pending_documents, 0);
+}
+
+// Handles "ready" from the Dart side: documents can be opened from now on.
+static void documents_method_call_cb(FlMethodChannel* channel,
+                                     FlMethodCall* method_call,
+                                     gpointer user_data) {
+  MyApplication* self = MY_APPLICATION(user_data);
+  if (strcmp(fl_method_call_get_name(method_call), "ready") != 0) {
+    g_autoptr(FlMethodResponse) response =
+        FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+    fl_method_call_respond(method_call, response, nullptr);
+    return;
+  }
+
+  self->documents_ready = TRUE;
+  g_autoptr(FlMethodResponse) response =
+      FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  fl_method_call_respond(method_call, response, nullptr);
+  flush_documents(self);
+}
+
 // Implements GApplication::activate.
 static void my_application_activate(GApplication* application) {
   MyApplication* self = MY_APPLICATION(application);
+  // In single-instance mode a second launch activates this process again;
+  // reuse the window and engine.
+  GtkWindow* active =
+      gtk_application_get_active_window(GTK_APPLICATION(application));
+  if (active != nullptr) {
+    gtk_window_present(active);
+    return;
+  }
+
   GtkWindow* window =
       GTK_WINDOW(gtk_application_window_new(GTK_APPLICATION(application)));
 
@@ -48,26 +206,128 @@ static void my_application_activate(GApplication* application) {
   }
 
   gtk_window_set_default_size(window, 1280, 720);
-  gtk_widget_show(GTK_WIDGET(window));
+  if (!self->fast_startup) {
+    gtk_widget_show(GTK_WIDGET(window));
+  }
 
   g_autoptr(FlDartProject) project = fl_dart_project_new();
+  startup_trace_mark("fl_dart_project_new");
   fl_dart_project_set_dart_entrypoint_arguments(project, self->dart_entrypoint_arguments);
 
   FlView* view = fl_view_new(project);
+  startup_trace_mark("fl_view_new");
+  g_signal_connect(view, "first-frame", G_CALLBACK(first_frame_cb), self);
   gtk_widget_show(GTK_WIDGET(view));
   gtk_container_add(GTK_CONTAINER(window), GTK_WIDGET(view));
 
-  fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+  // Set up before plugin registration so early Dart marks find a handler.
+  g_autoptr(FlStandardMethodCodec) startup_codec =
+      fl_standard_method_codec_new();
+  self->startup_channel = fl_method_channel_new(
+      fl_engine_get_binary_messenger(fl_view_get_engine(view)),
+      kStartupChannel, FL_METHOD_CODEC(startup_codec));
+  fl_method_channel_set_method_call_handler(
+      self->startup_channel, startup_method_call_cb, self, nullptr);
+
+  g_autoptr(FlStandardMethodCodec) documents_codec =
+      fl_standard_method_codec_new();
+  self->documents_channel = fl_method_channel_new(
+      fl_engine_get_binary_messenger(fl_view_get_engine(view)),
+      kDocumentsChannel, FL_METHOD_CODEC(documents_codec));
+  fl_method_channel_set_method_call_handler(
+      self->documents_channel, documents_method_call_cb, self, nullptr);
+
+  if (self->fast_startup) {
+    // The window is hidden, so realize the view to start the engine.
+    gtk_widget_realize(GTK_WIDGET(view));
+  } else {
+    fl_register_plugins(FL_PLUGIN_REGISTRY(view));
+    startup_trace_mark("fl_register_plugins");
+  }
+
+  if (self->benchmark_mode) {
+    FlEngine* engine = fl_view_get_engine(view);
+    g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+    self->benchmark_channel = fl_method_channel_new(
+        fl_engine_get_binary_messenger(engine), kBenchmarkChannel,
+        FL_METHOD_CODEC(codec));
+    fl_method_channel_set_method_call_handler(
+        self->benchmark_channel, benchmark_method_call_cb, self, nullptr);
+  }
 
   gtk_widget_grab_focus(GTK_WIDGET(view));
 }
 
+// Implements GApplication::open.
+static void my_application_open(GApplication* application, GFile** files,
+                                gint n_files, const gchar* hint) {
+  MyApplication* self = MY_APPLICATION(application);
+  for (gint i = 0; i < n_files; i++) {
+    gchar* path = g_file_get_path(files[i]);
+    if (path != nullptr) {
+      g_ptr_array_add(self->pending_documents, path);
+    }
+  }
+  my_application_activate(application);
+  flush_documents(self);
+}
+
 // Implements GApplication::local_command_line.
 static gboolean my_application_local_command_line(GApplication* application, gchar*** arguments, int* exit_status) {
   MyApplication* self = MY_APPLICATION(application);
   // Strip out the first argument as it is the binary name.
   self->dart_entrypoint_arguments = g_strdupv(*arguments + 1);
 
+  // The arguments also reach the Dart entrypoint, which drives the replay;
+  // validate them here so a bad nightly config fails before a window opens.
+  const gchar* session = nullptr;
+  const gchar* out = nullptr;
+  gboolean single_instance = FALSE;
+  for (gchar** arg = self->dart_entrypoint_arguments; *arg != nullptr; arg++) {
+    if (g_str_has_prefix(*arg, kBenchmarkArg)) {
+      session = *arg + strlen(kBenchmarkArg);
+    } else if (g_str_has_prefix(*arg, kBenchmarkOutArg)) {
+      out = *arg + strlen(kBenchmarkOutArg);
+    } else if (strcmp(*arg, kFastStartupArg) == 0) {
+      self->fast_startup = TRUE;
+    } else if (strcmp(*arg, kSingleInstanceArg) == 0) {
+      single_instance = TRUE;
+    } else if (g_str_has_prefix(*arg, kWatchdogArg)) {
+      const gchar* value = *arg + strlen(kWatchdogArg);
+      gchar* end = nullptr;
+      gint64 ms = g_ascii_strtoll(value, &end, 10);
+      if (end == value || *end != '\0' || ms < 0 || ms > G_MAXINT) {
+        g_printerr("%s needs a number of milliseconds\n", kWatchdogArg);
+        *exit_status = 2;
+        return TRUE;
+      }
+      self->watchdog_ms = static_cast<gint>(ms);
+    }
+  }
+  if (out != nullptr && session == nullptr) {
+    g_printerr("%s requires %s<session>\n", kBenchmarkOutArg, kBenchmarkArg);
+    *exit_status = 2;
+    return TRUE;
+  }
+  if (session != nullptr) {
+    if (!g_file_test(session, G_FILE_TEST_IS_REGULAR)) {
+      g_printerr("Benchmark session not found: %s\n", session);
+      *exit_status = 2;
+      return TRUE;
+    }
+    if (out != nullptr && out[0] == '\0') {
+      g_printerr("%s needs a file path\n", kBenchmarkOutArg);
+      *exit_status = 2;
+      return TRUE;
+    }
+    self->benchmark_mode = TRUE;
+  }
+
+  // Benchmark runs always get their own process.
+  if (single_instance && !self->benchmark_mode) {
+    g_application_set_flags(application, G_APPLICATION_HANDLES_OPEN);
+  }
+
   g_autoptr(GError) error = nullptr;
   if (!g_application_register(application, nullptr, &error)) {
      g_warning("Failed to register: %s", error->message);
@@ -75,19 +335,62 @@ static gboolean my_application_local_command_line(GApplication* application, gch
      return TRUE;
   }
 
-  g_application_activate(application);
+  // Arguments that are not options are documents. If another instance is
+  // primary, GApplication forwards the open (or activate) to it over D-Bus
+  // and this process exits.
+  g_autoptr(GPtrArray) files = g_ptr_array_new_with_free_func(g_object_unref);
+  for (gchar** arg = self->dart_entrypoint_arguments; *arg != nullptr; arg++) {
+    if ((*arg)[0] != '-') {
+      g_ptr_array_add(files, g_file_new_for_commandline_arg(*arg));
+    }
+  }
+  if (files->len > 0) {
+    g_application_open(application,
+                       reinterpret_cast<GFile**>(files->pdata), files->len,
+                       "");
+  } else {
+    g_application_activate(application);
+  }
   *exit_status = 0;
 
   return TRUE;
 }
 
+// Counts user input for the metrics registry, then hands every event to GTK
+// as its default handler does.
+static void metrics_event_handler(GdkEvent* event, gpointer user_data) {
+  switch (gdk_event_get_event_type(event)) {
+    case GDK_MOTION_NOTIFY:
+    case GDK_BUTTON_PRESS:
+    case GDK_BUTTON_RELEASE:
+    case GDK_TOUCH_BEGIN:
+    case GDK_TOUCH_UPDATE:
+    case GDK_TOUCH_END:
+    case GDK_SCROLL:
+    case GDK_KEY_PRESS:
+      sketcher_metric_add(kMetricInputEvents, 1);
+      break;
+    default:
+      break;
+  }
+  gtk_main_do_event(event);
+}
+
 // Implements GApplication::startup.
 static void my_application_startup(GApplication* application) {
-  //MyApplication* self = MY_APPLICATION(object);
+  MyApplication* self = MY_APPLICATION(application);
 
   // Perform any actions required at application startup.
 
   G_APPLICATION_CLASS(my_application_parent_class)->startup(application);
+  startup_trace_mark("startup");
+
+  // `kill -USR1 <pid>` prints frame, cache, input and memory metrics.
+  gdk_event_handler_set(metrics_event_handler, nullptr, nullptr);
+  metrics_install_dump_handler();
+
+  // Startup runs only in the primary instance, the one that draws frames.
+  watchdog_start(self->watchdog_ms);
 }
 
 // Implements GApplication::shutdown.
@@ -95,6 +398,9 @@ static void my_application_shutdown(GApplication* application) {
   //MyApplication* self = MY_APPLICATION(object);
 
   // Perform any actions required at application shutdown.
+  // Write whatever startup trace exists, e.g. if no frame was ever drawn.
+  startup_trace_write(TRUE);
+  watchdog_stop();
 
   G_APPLICATION_CLASS(my_application_parent_class)->shutdown(application);
 }
@@ -103,18 +409,38 @@ static void my_application_shutdown(GApplication* application) {
 static void my_application_dispose(GObject* object) {
   MyApplication* self = MY_APPLICATION(object);
   g_clear_pointer(&self->dart_entrypoint_arguments, g_strfreev);
+  g_clear_object(&self->benchmark_channel);
+  g_clear_object(&self->startup_channel);
+  g_clear_object(&self->documents_channel);
+  g_clear_pointer(&self->pending_documents, g_ptr_array_unref);
   G_OBJECT_CLASS(my_application_parent_class)->dispose(object);
 }
 
 static void my_application_class_init(MyApplicationClass* klass) {
   G_APPLICATION_CLASS(klass)->activate = my_application_activate;
   G_APPLICATION_CLASS(klass)->local_command_line = my_application_local_command_line;
+  G_APPLICATION_CLASS(klass)->open = my_application_open;
   G_APPLICATION_CLASS(klass)->startup = my_application_startup;
   G_APPLICATION_CLASS(klass)->shutdown = my_application_shutdown;
   G_OBJECT_CLASS(klass)->dispose = my_application_dispose;
 }
 
-static void my_application_init(MyApplication* self) {}
+static void my_application_init(MyApplication* self) {
+  self->benchmark_mode = FALSE;
+  self->exit_code = 0;
+  self->benchmark_channel = nullptr;
+  self->startup_channel = nullptr;
+  self->fast_startup = FALSE;
+  self->documents_channel = nullptr;
+  self->pending_documents = g_ptr_array_new_with_free_func(g_free);
+  self->documents_ready = FALSE;
+  self->watchdog_ms = kDefaultWatchdogMs;
+}
+
+int my_application_get_exit_code(MyApplication* self) {
+  g_return_val_if_fail(MY_IS_APPLICATION(self), 1);
+  return self->exit_code;
+}
 
 MyApplication* my_application_new() {
   // Set the program name to the application ID, which helps various systems
@@ -125,6 +451,6 @@ MyApplication* my_application_new() {
 
   return MY_APPLICATION(g_object_new(my_application_get_type(),
                                      "application-id", APPLICATION_ID,
-                                     "flags", G_APPLICATION_NON_UNIQUE,
+                                     "flags", G_APPLICATION_NON_UNIQUE | G_APPLICATION_HANDLES_OPEN,
                                      nullptr));
 }
@@ -15,4 +15,14 @@ G_DECLARE_FINAL_TYPE(MyApplication, my_application, MY, APPLICATION,
  */
 MyApplication* my_application_new();
 
+/**
+ * my_application_get_exit_code:
+ * @self: a #MyApplication.
+ *
+ * Gets the status reported by the Dart side in --benchmark mode.
+ *
+ * Returns: 0 unless a benchmark run reported a failure.
+ */
+int my_application_get_exit_code(MyApplication* self);
+
 #endif  // FLUTTER_MY_APPLICATION_H_
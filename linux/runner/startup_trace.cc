@@ -0,0 +1,97 @@
+#include "startup_trace.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+// Environment variable naming the Chrome trace output file.
+static constexpr char kTraceEnv[] = "SKETCH_STARTUP_TRACE";
+
+namespace {
+
+struct TraceMark {
+  std::string name;
+  std::string category;
+  gint64 micros;
+};
+
+std::vector<TraceMark>& marks() {
+  static std::vector<TraceMark> marks;
+  return marks;
+}
+
+bool written = false;
+
+const TraceMark* find_mark(const gchar* name) {
+  for (const TraceMark& mark : marks()) {
+    if (mark.name == name) {
+      return &mark;
+    }
+  }
+  return nullptr;
+}
+
+void append_event(GString* json, const gchar* name, const gchar* category,
+                  const gchar* phase, gint64 micros, gint64 duration) {
+  g_autofree gchar* escaped = g_strescape(name, nullptr);
+  if (json->str[json->len - 1] != '[') {
+    g_string_append(json, ",\n");
+  }
+  g_string_append_printf(json,
+                         "  {\"name\": \"%s\", \"cat\": \"%s\", "
+                         "\"ph\": \"%s\", \"ts\": %" G_GINT64_FORMAT
+                         ", \"pid\": %d, \"tid\": 1",
+                         escaped, category, phase, micros,
+                         static_cast<int>(getpid()));
+  if (duration >= 0) {
+    g_string_append_printf(json, ", \"dur\": %" G_GINT64_FORMAT, duration);
+  } else {
+    g_string_append(json, ", \"s\": \"p\"");
+  }
+  g_string_append(json, "}");
+}
+
+}  // namespace
+
+void startup_trace_mark(const gchar* name) {
+  startup_trace_mark_at(name, "runner", g_get_monotonic_time());
+}
+
+void startup_trace_mark_at(const gchar* name, const gchar* category,
+                           gint64 micros) {
+  marks().push_back(TraceMark{name, category, micros});
+}
+
+void startup_trace_write(gboolean force) {
+  const gchar* path = g_getenv(kTraceEnv);
+  if (written || path == nullptr || path[0] == '\0') {
+    return;
+  }
+  if (!force && (find_mark("first_frame") == nullptr ||
+                 find_mark("dart_first_paint") == nullptr)) {
+    return;
+  }
+  written = true;
+
+  g_autoptr(GString) json = g_string_new("{\"traceEvents\": [");
+  for (const TraceMark& mark : marks()) {
+    append_event(json, mark.name.c_str(), mark.category.c_str(), "i",
+                 mark.micros, -1);
+  }
+  // The contract metric, as one span from main() to the first frame.
+  const TraceMark* start = find_mark("main");
+  const TraceMark* first_frame = find_mark("first_frame");
+  if (start != nullptr && first_frame != nullptr) {
+    append_event(json, "time_to_first_frame", "runner", "X", start->micros,
+                 first_frame->micros - start->micros);
+    g_message("Startup: first frame %.1f ms after main",
+              (first_frame->micros - start->micros) / 1000.0);
+  }
+  g_string_append(json, "\n], \"displayTimeUnit\": \"ms\"}\n");
+
+  g_autoptr(GError) error = nullptr;
+  if (!g_file_set_contents(path, json->str, json->len, &error)) {
+    g_warning("Failed to write startup trace: %s", error->message);
+  }
+}
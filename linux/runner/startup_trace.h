@@ -0,0 +1,36 @@
+#ifndef FLUTTER_STARTUP_TRACE_H_
+#define FLUTTER_STARTUP_TRACE_H_
+
+#include <glib.h>
+
+/**
+ * startup_trace_mark:
+ * @name: the startup milestone that was just reached.
+ *
+ * Records @name at the current g_get_monotonic_time().
+ */
+void startup_trace_mark(const gchar* name);
+
+/**
+ * startup_trace_mark_at:
+ * @name: the milestone.
+ * @category: where it was taken, e.g. "dart".
+ * @micros: when it was taken, on the CLOCK_MONOTONIC timebase.
+ *
+ * Records a milestone timestamped elsewhere, such as in the Dart VM.
+ */
+void startup_trace_mark_at(const gchar* name, const gchar* category,
+                           gint64 micros);
+
+/**
+ * startup_trace_write:
+ * @force: write even if startup has not finished yet.
+ *
+ * Writes the marks as Chrome trace JSON to the file named by
+ * SKETCH_STARTUP_TRACE, once both the first frame and the first Dart paint
+ * have been marked. Does nothing when the variable is unset or the trace has
+ * already been written.
+ */
+void startup_trace_write(gboolean force);
+
+#endif  // FLUTTER_STARTUP_TRACE_H_
@@ -0,0 +1,236 @@
+#include "watchdog.h"
+
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "metrics.h"
+
+namespace {
+
+// The log rotates to .1, .2 and .3 once it reaches this size.
+constexpr gint64 kLogRotateBytes = 1 << 20;
+constexpr int kLogKeep = 3;
+
+const char* const kOpNames[] = {
+    "none",
+    "startStroke",
+    "addPoint",
+    "endStroke",
+    "undo",
+    "clear",
+    "loadDocument",
+    "export",
+};
+static_assert(sizeof(kOpNames) / sizeof(kOpNames[0]) == kWatchdogOpCount,
+              "every op needs a name");
+
+// Mirror DrawingTool and BrushMode in lib/models.
+const char* const kToolNames[] = {"pencil", "pen", "marker", "eraser",
+                                  "brush"};
+const char* const kBrushModeNames[] = {"charcoal", "watercolor",  "oilPaint",
+                                       "airbrush", "calligraphy", "pastel"};
+
+struct WatchdogState {
+  std::atomic<int32_t> threshold_ms;
+  // Time of the last beat; negated once Dart reports idle, 0 before the
+  // first beat.
+  std::atomic<int64_t> last_beat_us;
+  std::atomic<int32_t> op;
+  std::atomic<int32_t> stroke_count;
+  std::atomic<int32_t> point_count;
+  std::atomic<int32_t> tool;
+  std::atomic<int32_t> brush_mode;
+};
+
+// Zero-initialized static storage, like the metrics region.
+WatchdogState state;
+
+std::thread* thread = nullptr;
+std::mutex stop_mutex;
+std::condition_variable stop_cv;
+bool stop_requested = false;
+
+const char* name_or_index(const char* const* names, size_t count, int32_t id,
+                          char* buffer, size_t size) {
+  if (id >= 0 && static_cast<size_t>(id) < count) {
+    return names[id];
+  }
+  if (id < 0) {
+    return "none";
+  }
+  g_snprintf(buffer, size, "#%d", id);
+  return buffer;
+}
+
+gchar* log_path() {
+  const gchar* path = g_getenv("SKETCH_STALL_LOG");
+  if (path != nullptr && path[0] != '\0') {
+    return g_strdup(path);
+  }
+  return g_build_filename(g_get_user_cache_dir(), "sketcher", "stalls.log",
+                          nullptr);
+}
+
+void rotate_if_full(const gchar* path) {
+  GStatBuf info;
+  if (g_stat(path, &info) != 0 || info.st_size < kLogRotateBytes) {
+    return;
+  }
+  for (int i = kLogKeep - 1; i >= 1; i--) {
+    g_autofree gchar* from = g_strdup_printf("%s.%d", path, i);
+    g_autofree gchar* to = g_strdup_printf("%s.%d", path, i + 1);
+    g_rename(from, to);
+  }
+  g_autofree gchar* first = g_strdup_printf("%s.1", path);
+  g_rename(path, first);
+}
+
+// Appends @line to the stall log and echoes it to stderr.
+void write_log(const gchar* line) {
+  g_printerr("%s\n", line);
+
+  g_autofree gchar* path = log_path();
+  g_autofree gchar* dir = g_path_get_dirname(path);
+  g_mkdir_with_parents(dir, 0700);
+  rotate_if_full(path);
+  FILE* file = g_fopen(path, "a");
+  if (file == nullptr) {
+    return;
+  }
+  g_autoptr(GDateTime) now = g_date_time_new_now_local();
+  g_autofree gchar* stamp = g_date_time_format_iso8601(now);
+  fprintf(file, "%s %s\n", stamp, line);
+  fclose(file);
+}
+
+void log_stall(gint64 stalled_us) {
+  char tool_buffer[16];
+  char mode_buffer[16];
+  int32_t op = state.op.load(std::memory_order_relaxed);
+  g_autofree gchar* line = g_strdup_printf(
+      "UI stall: no heartbeat for %" G_GINT64_FORMAT
+      " ms; last_op=%s tool=%s brush_mode=%s strokes=%d points=%d"
+      " rss_bytes=%" G_GINT64_FORMAT " cached_image_bytes=%" G_GINT64_FORMAT,
+      stalled_us / 1000,
+      op >= 0 && op < kWatchdogOpCount ? kOpNames[op] : "unknown",
+      name_or_index(kToolNames, G_N_ELEMENTS(kToolNames),
+                    state.tool.load(std::memory_order_relaxed), tool_buffer,
+                    sizeof(tool_buffer)),
+      name_or_index(kBrushModeNames, G_N_ELEMENTS(kBrushModeNames),
+                    state.brush_mode.load(std::memory_order_relaxed),
+                    mode_buffer, sizeof(mode_buffer)),
+      state.stroke_count.load(std::memory_order_relaxed),
+      state.point_count.load(std::memory_order_relaxed),
+      static_cast<gint64>(metrics_sample_rss()),
+      static_cast<gint64>(metrics_gauge(kMetricCachedImageBytes)));
+  write_log(line);
+}
+
+bool is_beating() {
+  return state.last_beat_us.load(std::memory_order_relaxed) > 0;
+}
+
+// Polls the beat four times per threshold while the UI thread is busy. A
+// stall is logged once when it is detected and again, with its full length,
+// when beats resume. Before the first beat (startup has its own trace) and
+// while Dart reports idle, the thread sleeps until the next beat.
+void watchdog_main(gint threshold_ms) {
+  const gint64 threshold_us = static_cast<gint64>(threshold_ms) * 1000;
+  const auto poll = std::chrono::microseconds(threshold_us / 4);
+  gint64 stalled_since = 0;
+
+  std::unique_lock<std::mutex> lock(stop_mutex);
+  while (!stop_requested) {
+    if (stalled_since == 0 && !is_beating()) {
+      stop_cv.wait(lock, [] { return stop_requested || is_beating(); });
+      continue;
+    }
+    if (stop_cv.wait_for(lock, poll, [] { return stop_requested; })) {
+      break;
+    }
+    gint64 beat = state.last_beat_us.load(std::memory_order_relaxed);
+    const bool idle = beat < 0;
+    if (idle) {
+      beat = -beat;
+    }
+    gint64 now = g_get_monotonic_time();
+    // Logging happens outside the lock, which a beat may need to wake us.
+    if (stalled_since == 0 && !idle && now - beat > threshold_us) {
+      stalled_since = beat;
+      lock.unlock();
+      log_stall(now - beat);
+      lock.lock();
+    } else if (stalled_since != 0 && beat > stalled_since) {
+      gint64 length = beat - stalled_since;
+      sketcher_metric_add(kMetricUiStalls, 1);
+      sketcher_metric_record(kMetricUiStallUs, length);
+      g_autofree gchar* line = g_strdup_printf(
+          "UI stall ended after %" G_GINT64_FORMAT " ms", length / 1000);
+      stalled_since = 0;
+      lock.unlock();
+      write_log(line);
+      lock.lock();
+    }
+  }
+}
+
+}  // namespace
+
+int32_t sketcher_watchdog_threshold_ms() {
+  return state.threshold_ms.load(std::memory_order_relaxed);
+}
+
+void sketcher_watchdog_beat() {
+  int64_t previous = state.last_beat_us.exchange(g_get_monotonic_time(),
+                                                 std::memory_order_relaxed);
+  if (previous <= 0) {
+    // Leaving idle: the watchdog thread is asleep until told otherwise.
+    { std::lock_guard<std::mutex> lock(stop_mutex); }
+    stop_cv.notify_one();
+  }
+}
+
+void sketcher_watchdog_idle() {
+  state.last_beat_us.store(-g_get_monotonic_time(),
+                           std::memory_order_relaxed);
+}
+
+void sketcher_watchdog_context(int32_t op, int32_t stroke_count,
+                               int32_t point_count, int32_t tool,
+                               int32_t brush_mode) {
+  state.op.store(op, std::memory_order_relaxed);
+  state.stroke_count.store(stroke_count, std::memory_order_relaxed);
+  state.point_count.store(point_count, std::memory_order_relaxed);
+  state.tool.store(tool, std::memory_order_relaxed);
+  state.brush_mode.store(brush_mode, std::memory_order_relaxed);
+}
+
+void watchdog_start(gint threshold_ms) {
+  if (thread != nullptr || threshold_ms <= 0) {
+    return;
+  }
+  state.threshold_ms.store(threshold_ms, std::memory_order_relaxed);
+  thread = new std::thread(watchdog_main, threshold_ms);
+}
+
+void watchdog_stop() {
+  if (thread == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(stop_mutex);
+    stop_requested = true;
+  }
+  stop_cv.notify_one();
+  thread->join();
+  delete thread;
+  thread = nullptr;
+  state.threshold_ms.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,86 @@
+#ifndef FLUTTER_WATCHDOG_H_
+#define FLUTTER_WATCHDOG_H_
+
+#include <glib.h>
+#include <stdint.h>
+
+// UI-thread stall watchdog. Dart beats on every frame and stroke operation,
+// and reports idle once no frame is scheduled; a native thread logs a stall,
+// with the drawing context Dart last reported, when no beat arrives within
+// the threshold. While the UI thread is idle the native thread sleeps instead
+// of polling. Beats and context are relaxed atomics in a static region,
+// written through leaf FFI calls.
+//
+// Op, tool and brush mode ids must match lib/utils/stall_watchdog.dart.
+
+#define SKETCHER_WATCHDOG_EXPORT \
+  extern "C" __attribute__((visibility("default")))
+
+enum WatchdogStrokeOp : int32_t {
+  kWatchdogOpNone,
+  kWatchdogOpStartStroke,
+  kWatchdogOpAddPoint,
+  kWatchdogOpEndStroke,
+  kWatchdogOpUndo,
+  kWatchdogOpClear,
+  kWatchdogOpLoadDocument,
+  kWatchdogOpExport,
+  kWatchdogOpCount,
+};
+
+/**
+ * sketcher_watchdog_threshold_ms:
+ *
+ * Returns: the stall threshold, or 0 if the watchdog is not running.
+ */
+SKETCHER_WATCHDOG_EXPORT int32_t sketcher_watchdog_threshold_ms();
+
+/**
+ * sketcher_watchdog_beat:
+ *
+ * Records that the UI thread is alive, at g_get_monotonic_time().
+ */
+SKETCHER_WATCHDOG_EXPORT void sketcher_watchdog_beat();
+
+/**
+ * sketcher_watchdog_idle:
+ *
+ * Records that the UI thread has nothing scheduled, so its silence until the
+ * next beat is not a stall.
+ */
+SKETCHER_WATCHDOG_EXPORT void sketcher_watchdog_idle();
+
+/**
+ * sketcher_watchdog_context:
+ * @op: the #WatchdogStrokeOp just entered.
+ * @stroke_count: committed strokes.
+ * @point_count: points in the stroke being drawn.
+ * @tool: DrawingTool index.
+ * @brush_mode: BrushMode index, or -1 for none.
+ *
+ * Records what the UI thread is doing, for the stall log.
+ */
+SKETCHER_WATCHDOG_EXPORT void sketcher_watchdog_context(int32_t op,
+                                                        int32_t stroke_count,
+                                                        int32_t point_count,
+                                                        int32_t tool,
+                                                        int32_t brush_mode);
+
+/**
+ * watchdog_start:
+ * @threshold_ms: how long the UI thread may go without a beat.
+ *
+ * Starts the watchdog thread. Stalls are appended to the file named by
+ * SKETCH_STALL_LOG, or to $XDG_CACHE_HOME/sketcher/stalls.log, which rotates
+ * at 1 MiB. Monitoring begins with the first beat.
+ */
+void watchdog_start(gint threshold_ms);
+
+/**
+ * watchdog_stop:
+ *
+ * Stops and joins the watchdog thread, if it was started.
+ */
+void watchdog_stop();
+
+#endif  // FLUTTER_WATCHDOG_H_
@@ -0,0 +1,121 @@
+// Allocation budgets for the drawing hot path, measured with the VM
+// service allocation profiler:
+//
+//   flutter test --enable-vmservice test/allocation_budget_test.dart
+//
+// Without a VM service the tests are skipped. Budgets are ceilings on heap
+// objects; when an optimization removes allocations, lower them to match.
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:get/get.dart';
+import 'package:professional_sketcher/controllers/sketch_controller.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import '../benchmark/support/allocation_probe.dart';
+import '../benchmark/support/synthetic_strokes.dart';
+
+const int _points = 200;
+const int _strokes = 40;
+const int _pointsPerStroke = 32;
+const Size _canvasSize = Size(1024, 768);
+
+// Objects per point over startStroke + addPoint × N + endStroke, including
+// the live-preview Stroke rebuilt on every point.
+const int _budgetPerAddedPoint = 24;
+
+// Objects per committed stroke per repaint, with warm paint caches.
+const int _defaultBudgetPerStroke = 8 * _pointsPerStroke;
+const Map<String, int> _budgetPerStroke = {
+  'pen': 4 * _pointsPerStroke,
+  'marker': 4 * _pointsPerStroke,
+};
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  AllocationProbe? probe;
+  int baseline = 0;
+
+  // Instances allocated by [work], less the probe's own round trip.
+  Future<int> instancesDuring(void Function() work) async {
+    await probe!.start();
+    work();
+    final sample = await probe!.stop();
+    return sample.instances - baseline;
+  }
+
+  setUpAll(() async {
+    probe = await AllocationProbe.connect();
+    if (probe == null) return;
+    await probe!.start();
+    baseline = (await probe!.stop()).instances;
+  });
+
+  tearDownAll(() async {
+    await probe?.dispose();
+  });
+
+  group('Allocation budgets', () {
+    setUp(() {
+      Get.testMode = true;
+      SketchPainter.clearStrokeCache();
+      SketchPainter.clearBoundsCache();
+    });
+
+    test('SketchController allocates within budget per added point',
+        () async {
+      if (probe == null) {
+        markTestSkipped('needs flutter test --enable-vmservice');
+        return;
+      }
+      final controller = SketchController();
+      controller.setTool(DrawingTool.pen);
+
+      void drawStroke() {
+        controller.startStroke(const Offset(10, 10), 1.0);
+        for (int i = 1; i <= _points; i++) {
+          controller.addPoint(Offset(10.0 + i * 2, 10.0 + (i % 7)), 1.0);
+        }
+        controller.endStroke();
+      }
+
+      drawStroke(); // Warm-up: first-call setup is not per-point cost
+      final instances = await instancesDuring(drawStroke);
+      final perPoint = instances / _points;
+
+      expect(perPoint, lessThanOrEqualTo(_budgetPerAddedPoint),
+          reason: '$instances objects for $_points points');
+    });
+
+    for (final tool in BenchTool.all) {
+      test('SketchPainter allocates within budget per ${tool.name} stroke',
+          () async {
+        if (probe == null) {
+          markTestSkipped('needs flutter test --enable-vmservice');
+          return;
+        }
+        final strokes = SyntheticStrokes.rows(
+          tool,
+          count: _strokes,
+          pointCount: _pointsPerStroke,
+          width: 8.0,
+          size: _canvasSize,
+        );
+        final painter = SketchPainter(strokes: strokes, isImageVisible: false);
+        final recorder = ui.PictureRecorder();
+        final canvas = Canvas(recorder);
+
+        painter.paint(canvas, _canvasSize); // Fills the paint caches
+        final instances =
+            await instancesDuring(() => painter.paint(canvas, _canvasSize));
+        recorder.endRecording().dispose();
+        final perStroke = instances / _strokes;
+
+        final budget = _budgetPerStroke[tool.name] ?? _defaultBudgetPerStroke;
+        expect(perStroke, lessThanOrEqualTo(budget),
+            reason: '$instances objects for $_strokes strokes');
+      });
+    }
+  });
+}
@@ -1,8 +1,22 @@
+import 'dart:math' as math;
 import 'package:flutter_test/flutter_test.dart';
 import 'package:flutter/material.dart';
 import 'package:get/get.dart';
 import 'package:professional_sketcher/controllers/sketch_controller.dart';
 import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/eraser_mode.dart';
+import 'package:professional_sketcher/models/sketch_document.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+
+/// Draws a stroke from [from] to [to] through [steps] evenly spaced points.
+void _drawLine(SketchController controller, Offset from, Offset to,
+    {int steps = 2}) {
+  controller.startStroke(from, 1.0);
+  for (int i = 1; i <= steps; i++) {
+    controller.addPoint(Offset.lerp(from, to, i / steps)!, 1.0);
+  }
+  controller.endStroke();
+}
 
 void main() {
   group('SketchController Tests', () {
@@ -183,6 +197,432 @@ void main() {
       });
     });
 
+    group('Vector Eraser Tests', () {
+      void eraseLine(Offset from, Offset to) {
+        controller.setTool(DrawingTool.eraser);
+        controller.setEraserMode(EraserMode.vector);
+        _drawLine(controller, from, to, steps: 4);
+      }
+
+      test('should split a crossed stroke and not keep the eraser', () {
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(0, 50), const Offset(200, 50),
+            steps: 20);
+
+        eraseLine(const Offset(100, 0), const Offset(100, 100));
+
+        expect(controller.strokes, hasLength(2));
+        expect(controller.strokes.any((s) => s.isEraser), isFalse);
+        final left = controller.strokes[0].points;
+        final right = controller.strokes[1].points;
+        // Eraser radius 3 plus half the pen width 1
+        expect(left.last.offset.dx, closeTo(96, 0.05));
+        expect(right.first.offset.dx, closeTo(104, 0.05));
+      });
+
+      test('should keep strokes the eraser misses', () {
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(0, 50), const Offset(200, 50),
+            steps: 20);
+        _drawLine(controller, const Offset(0, 150), const Offset(200, 150),
+            steps: 20);
+        final missed = controller.strokes[1];
+
+        eraseLine(const Offset(100, 0), const Offset(100, 100));
+
+        expect(controller.strokes, hasLength(3));
+        expect(identical(controller.strokes.last, missed), isTrue);
+      });
+
+      test('should leave brush strokes alone', () {
+        controller.setTool(DrawingTool.brush);
+        _drawLine(controller, const Offset(0, 50), const Offset(200, 50),
+            steps: 20);
+
+        eraseLine(const Offset(100, 0), const Offset(100, 100));
+
+        expect(controller.strokes, hasLength(1));
+        expect(controller.strokes.single.tool, DrawingTool.brush);
+      });
+
+      test('should undo an erase back to the original stroke', () {
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(0, 50), const Offset(200, 50),
+            steps: 20);
+        final original = controller.strokes.single;
+
+        eraseLine(const Offset(100, 0), const Offset(100, 100));
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(0, 150), const Offset(200, 150),
+            steps: 20);
+        expect(controller.strokes, hasLength(3));
+
+        controller.undo(); // The later pen stroke
+        expect(controller.strokes, hasLength(2));
+        controller.undo(); // The erase
+        expect(controller.strokes, hasLength(1));
+        expect(identical(controller.strokes.single, original), isTrue);
+      });
+    });
+
+    group('Object Eraser Tests', () {
+      setUp(() {
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(0, 50), const Offset(200, 50),
+            steps: 10);
+        _drawLine(controller, const Offset(0, 150), const Offset(200, 150),
+            steps: 10);
+        controller.setTool(DrawingTool.eraser);
+        controller.setEraserMode(EraserMode.object);
+      });
+
+      test('should delete touched strokes while the pointer moves', () {
+        final kept = controller.strokes.last;
+
+        controller.startStroke(const Offset(100, 0), 1.0);
+        controller.addPoint(const Offset(100, 100), 1.0);
+
+        expect(controller.strokes, [kept]);
+        expect(controller.currentStroke, isNull);
+      });
+
+      test('should not commit an eraser stroke', () {
+        controller.startStroke(const Offset(100, 0), 1.0);
+        controller.addPoint(const Offset(100, 200), 1.0);
+        controller.endStroke();
+
+        expect(controller.strokes, isEmpty);
+      });
+
+      test('should undo a whole object erase in one step', () {
+        final before = controller.strokes.toList();
+
+        controller.startStroke(const Offset(50, 0), 1.0);
+        controller.addPoint(const Offset(50, 100), 1.0);
+        controller.addPoint(const Offset(50, 200), 1.0);
+        controller.endStroke();
+        expect(controller.strokes, isEmpty);
+
+        controller.undo();
+        expect(controller.strokes, before);
+      });
+
+      test('should leave the document alone when nothing is hit', () {
+        final before = controller.strokes.toList();
+
+        controller.startStroke(const Offset(100, 100), 1.0);
+        controller.addPoint(const Offset(120, 100), 1.0);
+        controller.endStroke();
+        controller.undo(); // Removes the last pen stroke as usual
+
+        expect(controller.strokes, [before.first]);
+      });
+    });
+
+    group('Lasso Selection Tests', () {
+      void lasso(List<Offset> corners) {
+        controller.beginLasso(corners.first);
+        for (final corner in corners.skip(1)) {
+          controller.extendLasso(corner);
+        }
+        controller.endLasso();
+      }
+
+      setUp(() {
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(100, 100), const Offset(200, 100));
+        _drawLine(controller, const Offset(100, 300), const Offset(200, 300));
+        controller.setLassoMode(true);
+      });
+
+      test('should select strokes inside the lasso', () {
+        lasso(const [
+          Offset(50, 50),
+          Offset(250, 50),
+          Offset(250, 150),
+          Offset(50, 150),
+        ]);
+
+        expect(controller.selection, [controller.strokes.first]);
+        expect(controller.selectionBounds,
+            const Rect.fromLTRB(99, 99, 201, 101));
+        expect(controller.lassoPath, isEmpty);
+      });
+
+      test('should keep the stroke layer intact until the drag starts', () {
+        lasso(const [Offset(0, 50), Offset(300, 50), Offset(150, 200)]);
+
+        controller.beginSelectionTransform();
+
+        expect(controller.isTransformingSelection, isTrue);
+        expect(controller.unselectedStrokes, [controller.strokes.last]);
+        expect(controller.strokes, hasLength(2));
+      });
+
+      test('should only touch point data on commit', () {
+        lasso(const [Offset(0, 50), Offset(300, 50), Offset(150, 200)]);
+        final original = controller.strokes.first;
+
+        controller.beginSelectionTransform();
+        controller.setSelectionTransform(offset: const Offset(10, 20));
+        expect(identical(controller.strokes.first, original), isTrue);
+
+        controller.commitSelectionTransform();
+        final moved = controller.strokes.first;
+        expect(moved.points.first.offset, const Offset(110, 120));
+        expect(moved.points.last.offset, const Offset(210, 120));
+        expect(controller.selection, [moved]);
+        expect(controller.isTransformingSelection, isFalse);
+      });
+
+      test('should scale widths and rotate about the selection centre', () {
+        lasso(const [Offset(0, 50), Offset(300, 50), Offset(150, 200)]);
+        final width = controller.strokes.first.width;
+
+        controller.beginSelectionTransform();
+        controller.setSelectionTransform(scale: 2.0, rotation: math.pi / 2);
+        controller.commitSelectionTransform();
+
+        final points = controller.strokes.first.points;
+        expect(controller.strokes.first.width, width * 2);
+        expect(points.first.offset.dx, closeTo(150, 1e-9));
+        expect(points.first.offset.dy, closeTo(0, 1e-9));
+        expect(points.last.offset.dy, closeTo(200, 1e-9));
+      });
+
+      test('should undo a committed transform', () {
+        lasso(const [Offset(0, 50), Offset(300, 50), Offset(150, 200)]);
+        final original = controller.strokes.first;
+
+        controller.beginSelectionTransform();
+        controller.setSelectionTransform(offset: const Offset(10, 20));
+        controller.commitSelectionTransform();
+        controller.undo();
+
+        expect(controller.strokes, hasLength(2));
+        expect(identical(controller.strokes.first, original), isTrue);
+        expect(controller.hasSelection, isFalse);
+      });
+
+      test('should clear the selection when lasso mode ends', () {
+        lasso(const [Offset(0, 50), Offset(300, 50), Offset(150, 200)]);
+
+        controller.setLassoMode(false);
+
+        expect(controller.hasSelection, isFalse);
+        expect(controller.selectionBounds, isNull);
+      });
+    });
+
+    group('Layer Tests', () {
+      test('should start with one active layer', () {
+        expect(controller.layers, hasLength(1));
+        expect(controller.activeLayerIndex.value, 0);
+        expect(identical(controller.strokes, controller.activeLayer.strokes),
+            isTrue);
+      });
+
+      test('should draw on the active layer only', () {
+        _drawLine(controller, const Offset(10, 10), const Offset(50, 10));
+        controller.addLayer();
+        _drawLine(controller, const Offset(10, 40), const Offset(50, 40));
+
+        expect(controller.activeLayerIndex.value, 1);
+        expect(controller.layers[0].strokes, hasLength(1));
+        expect(controller.layers[1].strokes, hasLength(1));
+        expect(controller.strokes, same(controller.layers[1].strokes));
+        expect(controller.allStrokes, hasLength(2));
+      });
+
+      test('should erase only the active layer', () {
+        controller.setTool(DrawingTool.pen);
+        _drawLine(controller, const Offset(100, 100), const Offset(200, 100));
+        controller.addLayer();
+        _drawLine(controller, const Offset(100, 120), const Offset(200, 120));
+
+        controller.setTool(DrawingTool.eraser);
+        controller.setEraserMode(EraserMode.object);
+        controller.startStroke(const Offset(150, 80), 1.0);
+        controller.addPoint(const Offset(150, 140), 1.0);
+        controller.endStroke();
+
+        expect(controller.layers[0].strokes, hasLength(1));
+        expect(controller.layers[1].strokes, isEmpty);
+      });
+
+      test('should undo the latest step whichever layer is active', () {
+        _drawLine(controller, const Offset(10, 10), const Offset(50, 10));
+        controller.addLayer();
+        _drawLine(controller, const Offset(10, 40), const Offset(50, 40));
+        final top = controller.layers[1];
+
+        controller.setActiveLayer(0);
+        controller.undo();
+
+        expect(controller.layers[0].strokes, hasLength(1));
+        expect(controller.layers[1].strokes, isEmpty);
+        // The top layer's picture is stale once its strokes change
+        expect(controller.layers[1].revision, greaterThan(top.revision));
+      });
+
+      test('should undo adding a layer', () {
+        _drawLine(controller, const Offset(10, 10), const Offset(50, 10));
+        controller.addLayer();
+        _drawLine(controller, const Offset(10, 40), const Offset(50, 40));
+
+        controller.undo(); // The stroke on the new layer
+        controller.undo(); // The new layer
+
+        expect(controller.layers, hasLength(1));
+        expect(controller.activeLayerIndex.value, 0);
+        expect(controller.strokes, hasLength(1));
+      });
+
+      test('should undo removing a layer', () {
+        _drawLine(controller, const Offset(10, 10), const Offset(50, 10));
+        controller.addLayer();
+        _drawLine(controller, const Offset(10, 40), const Offset(50, 40));
+        controller.setLayerBlendMode(1, BlendMode.multiply);
+        final removed = controller.layers[1];
+
+        controller.removeLayer(1);
+        expect(controller.layers, hasLength(1));
+
+        controller.undo();
+
+        expect(controller.layers, hasLength(2));
+        expect(controller.activeLayerIndex.value, 1);
+        expect(controller.activeLayer.id, removed.id);
+        expect(controller.activeLayer.blendMode, BlendMode.multiply);
+        expect(controller.strokes, same(removed.strokes));
+        expect(controller.strokes, hasLength(1));
+      });
+
+      test('should undo layer setting changes one at a time', () {
+        controller.addLayer();
+        controller.setLayerVisible(1, false);
+        controller.setLayerBlendMode(1, BlendMode.screen);
+
+        controller.undo();
+        expect(controller.layers[1].blendMode, BlendMode.srcOver);
+        expect(controller.layers[1].visible, isFalse);
+
+        controller.undo();
+        expect(controller.layers[1].visible, isTrue);
+        expect(controller.layers, hasLength(2));
+      });
+
+      test('should undo an opacity drag in one step', () {
+        controller.addLayer();
+        for (final opacity in [0.9, 0.7, 0.5, 0.3]) {
+          controller.setLayerOpacity(1, opacity);
+        }
+        controller.endLayerOpacityChange();
+
+        controller.undo();
+
+        expect(controller.layers, hasLength(2));
+        expect(controller.layers[1].opacity, 1.0);
+      });
+
+      test('should undo two opacity drags as two steps', () {
+        controller.addLayer();
+        for (final opacity in [0.9, 0.7]) {
+          controller.setLayerOpacity(1, opacity);
+        }
+        controller.endLayerOpacityChange();
+        for (final opacity in [0.5, 0.3]) {
+          controller.setLayerOpacity(1, opacity);
+        }
+        controller.endLayerOpacityChange();
+
+        controller.undo();
+        expect(controller.layers[1].opacity, 0.7);
+
+        controller.undo();
+        expect(controller.layers[1].opacity, 1.0);
+        expect(controller.layers, hasLength(2));
+      });
+
+      test('should mark a layer changed when it stops being active', () {
+        controller.addLayer();
+        final bottom = controller.layers[0];
+        final top = controller.layers[1];
+
+        controller.setActiveLayer(0);
+
+        expect(identical(controller.layers[0], bottom), isTrue);
+        expect(controller.layers[1].revision, top.revision + 1);
+        expect(controller.layers[1].strokes, same(top.strokes));
+      });
+
+      test('should replace a layer when its settings change', () {
+        final layer = controller.layers.single;
+
+        controller.setLayerOpacity(0, 1.5);
+        controller.setLayerBlendMode(0, BlendMode.multiply);
+        controller.setLayerVisible(0, false);
+
+        final changed = controller.layers.single;
+        expect(identical(changed, layer), isFalse);
+        expect(changed.opacity, 1.0);
+        expect(changed.blendMode, BlendMode.multiply);
+        expect(changed.visible, isFalse);
+        expect(changed.strokes, same(layer.strokes));
+      });
+
+      test('should keep the active layer when a layer below is removed', () {
+        controller.addLayer();
+        controller.addLayer();
+        final active = controller.activeLayer;
+
+        controller.removeLayer(0);
+
+        expect(controller.layers, hasLength(2));
+        expect(controller.activeLayerIndex.value, 1);
+        expect(controller.activeLayer.id, active.id);
+      });
+
+      test('should never remove the last layer', () {
+        controller.removeLayer(0);
+        expect(controller.layers, hasLength(1));
+      });
+
+      test('should clear every layer and keep the layers', () {
+        _drawLine(controller, const Offset(10, 10), const Offset(50, 10));
+        controller.addLayer();
+        _drawLine(controller, const Offset(10, 40), const Offset(50, 40));
+
+        controller.clear();
+
+        expect(controller.layers, hasLength(2));
+        expect(controller.allStrokes, isEmpty);
+      });
+
+      test('should load a document onto a single layer', () {
+        controller.addLayer();
+        final stroke = Stroke(
+          points: [DrawingPoint(offset: const Offset(1, 1), timestamp: 0)],
+          color: Colors.red,
+          width: 3.0,
+          tool: DrawingTool.pen,
+        );
+        controller.loadDocument(SketchDocument(
+          canvasSize: const Size(100, 100),
+          strokes: [stroke],
+        ));
+
+        expect(controller.layers, hasLength(1));
+        expect(controller.activeLayerIndex.value, 0);
+        expect(controller.strokes, hasLength(1));
+
+        controller.undo();
+        expect(controller.layers, hasLength(2));
+        expect(controller.activeLayerIndex.value, 1);
+        expect(controller.allStrokes, isEmpty);
+      });
+    });
+
     group('Tool Properties Tests', () {
       test('should detect pressure sensitive tools correctly', () {
         controller.setTool(DrawingTool.pencil);
@@ -286,6 +726,33 @@ void main() {
         controller.clear();
         expect(controller.strokes, isEmpty);
       });
+
+      test('should load a document as one undo step', () {
+        controller.startStroke(const Offset(10, 10), 1.0);
+        controller.endStroke();
+        controller.transformationController.value =
+            Matrix4.diagonal3Values(2.0, 2.0, 1.0);
+
+        final stroke = Stroke(
+          points: [DrawingPoint(offset: const Offset(1, 1), timestamp: 0)],
+          color: Colors.red,
+          width: 3.0,
+          tool: DrawingTool.pen,
+        );
+        controller.loadDocument(SketchDocument(
+          canvasSize: const Size(100, 100),
+          strokes: [stroke, stroke],
+        ));
+
+        expect(controller.strokes, hasLength(2));
+        expect(controller.zoomScale, 1.0);
+
+        controller.undo();
+        expect(controller.strokes, hasLength(1));
+        expect(controller.strokes.single.points.first.offset,
+            const Offset(10, 10));
+        expect(controller.zoomScale, 2.0);
+      });
     });
 
     group('Background Image Tests', () {
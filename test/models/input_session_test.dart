@@ -0,0 +1,125 @@
+import 'dart:typed_data';
+import 'dart:ui';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/input_session.dart';
+
+void main() {
+  group('InputSession Tests', () {
+    final session = InputSession(
+      canvasSize: const Size(800, 600),
+      events: const [
+        InputEvent(type: InputEventType.tool, timeMicros: 0, value: 2),
+        InputEvent(
+          type: InputEventType.color,
+          timeMicros: 0,
+          value: 0xFF2196F3,
+        ),
+        InputEvent(
+          type: InputEventType.view,
+          timeMicros: 10,
+          value: 2.0,
+          position: Offset(-40, -25),
+        ),
+        InputEvent(
+          type: InputEventType.down,
+          timeMicros: 1000,
+          pointer: 7,
+          kind: PointerDeviceKind.stylus,
+          position: Offset(10.5, 20.25),
+          pressure: 0.5,
+          orientation: 0.25,
+        ),
+        InputEvent(
+          type: InputEventType.move,
+          timeMicros: 9000,
+          pointer: 7,
+          kind: PointerDeviceKind.stylus,
+          pointerCount: 1,
+          position: Offset(30, 40),
+        ),
+        InputEvent(
+          type: InputEventType.up,
+          timeMicros: 17000,
+          pointer: 7,
+          kind: PointerDeviceKind.stylus,
+          pointerCount: 1,
+          position: Offset(30, 40),
+          pressure: 0.0,
+        ),
+      ],
+    );
+
+    test('should round-trip through the binary format', () {
+      final decoded = InputSession.fromBytes(session.toBytes());
+
+      expect(decoded.canvasSize, session.canvasSize);
+      expect(decoded.events.length, session.events.length);
+      for (int i = 0; i < session.events.length; i++) {
+        final a = session.events[i];
+        final b = decoded.events[i];
+        expect(b.type, a.type);
+        expect(b.timeMicros, a.timeMicros);
+        expect(b.value, a.value);
+        expect(b.position, a.position);
+        if (a.isPointer) {
+          expect(b.pointer, a.pointer);
+          expect(b.kind, a.kind);
+          expect(b.pointerCount, a.pointerCount);
+          expect(b.pressure, a.pressure);
+          expect(b.orientation, a.orientation);
+        }
+      }
+      expect(decoded.strokeCount, 1);
+      expect(decoded.duration, const Duration(microseconds: 17000));
+    });
+
+    test('should stay compact', () {
+      // 17-byte header, 3 pointer events, 2 settings, 1 view change
+      expect(session.toBytes().length, 17 + 3 * 25 + 2 * 13 + 17);
+    });
+
+    test('should round-trip layer events', () {
+      final layered = InputSession(
+        canvasSize: const Size(800, 600),
+        events: const [
+          InputEvent(type: InputEventType.eraserMode, timeMicros: 0, value: 1),
+          InputEvent(type: InputEventType.lassoMode, timeMicros: 5, value: 1),
+          InputEvent(type: InputEventType.addLayer, timeMicros: 10),
+          InputEvent(
+            type: InputEventType.layerOpacity,
+            timeMicros: 20,
+            layer: 1,
+            value: 0.4,
+          ),
+        ],
+      );
+      final bytes = layered.toBytes();
+      final decoded = InputSession.fromBytes(bytes);
+
+      // 17-byte header, 2 settings, 2 layer events
+      expect(bytes.length, 17 + 2 * 13 + 2 * 15);
+      expect([for (final e in decoded.events) e.type],
+          [for (final e in layered.events) e.type]);
+      expect(decoded.events.last.layer, 1);
+      expect(decoded.events.last.value, 0.4);
+      expect(decoded.events.last.isLayer, isTrue);
+      expect(decoded.events.first.isLayer, isFalse);
+    });
+
+    test('should still read version 1 sessions', () {
+      final bytes = session.toBytes()..[4] = 1;
+      expect(InputSession.fromBytes(bytes).events.length, 6);
+    });
+
+    test('should reject foreign or truncated data', () {
+      final bytes = session.toBytes();
+      expect(() => InputSession.fromBytes(Uint8List(4)),
+          throwsA(isA<FormatException>()));
+      expect(() => InputSession.fromBytes(Uint8List.fromList(
+              [0x50, 0x4E, 0x47, 0x00, ...bytes.sublist(4)])),
+          throwsA(isA<FormatException>()));
+      expect(() => InputSession.fromBytes(bytes.sublist(0, bytes.length - 3)),
+          throwsA(isA<FormatException>()));
+    });
+  });
+}
@@ -0,0 +1,99 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:flutter/material.dart';
+import 'package:professional_sketcher/models/brush_mode.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/sketch_document.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/utils/headless_render.dart';
+
+void main() {
+  group('SketchDocument', () {
+    test('round-trips strokes through JSON', () {
+      final document = SketchDocument(
+        canvasSize: const Size(640, 480),
+        strokes: [
+          Stroke(
+            points: [
+              DrawingPoint(
+                  offset: const Offset(1, 2), pressure: 0.5, timestamp: 10),
+              DrawingPoint(offset: const Offset(3, 4), timestamp: 20),
+            ],
+            color: const Color(0xFF112233),
+            width: 4.0,
+            tool: DrawingTool.brush,
+            opacity: 0.7,
+            brushMode: BrushMode.watercolor,
+          ),
+          Stroke(
+            points: [DrawingPoint(offset: const Offset(5, 6), timestamp: 30)],
+            color: Colors.white,
+            width: 12.0,
+            tool: DrawingTool.eraser,
+            blendMode: BlendMode.clear,
+            isEraser: true,
+          ),
+        ],
+      );
+
+      final copy = SketchDocument.fromJson(document.toJson());
+
+      expect(copy.canvasSize, const Size(640, 480));
+      expect(copy.strokes, hasLength(2));
+      final brush = copy.strokes.first;
+      expect(brush.tool, DrawingTool.brush);
+      expect(brush.brushMode, BrushMode.watercolor);
+      expect(brush.color, const Color(0xFF112233));
+      expect(brush.opacity, 0.7);
+      expect(brush.points.first.offset, const Offset(1, 2));
+      expect(brush.points.first.pressure, 0.5);
+      expect(brush.points.last.timestamp, 20);
+      final eraser = copy.strokes.last;
+      expect(eraser.isEraser, isTrue);
+      expect(eraser.blendMode, BlendMode.clear);
+      expect(eraser.brushMode, isNull);
+    });
+
+    test('rejects malformed documents', () {
+      expect(() => SketchDocument.fromJson({'version': 99}),
+          throwsFormatException);
+      expect(
+          () => SketchDocument.fromJson({
+                'version': 1,
+                'width': 10,
+                'height': 10,
+                'strokes': [
+                  {'tool': 'pen', 'color': 0, 'width': 1, 'points': [1, 2, 3]}
+                ],
+              }),
+          throwsFormatException);
+      expect(
+          () => SketchDocument.fromJson(
+              {'version': 1, 'width': 10, 'height': 10, 'strokes': 'x'}),
+          throwsFormatException);
+    });
+  });
+
+  group('HeadlessRenderOptions', () {
+    test('needs --headless-render and an input directory', () {
+      expect(HeadlessRenderOptions.fromArgs(['--input=docs']), isNull);
+      expect(HeadlessRenderOptions.fromArgs(['--headless-render']), isNull);
+    });
+
+    test('parses output, thumbnail and shard', () {
+      final options = HeadlessRenderOptions.fromArgs([
+        '--headless-render',
+        '--input=docs',
+        '--thumbnail=256',
+        '--shard=2/4',
+      ])!;
+      expect(options.outputDir, 'docs');
+      expect(options.thumbnail, 256);
+      expect(options.shardIndex, 2);
+      expect(options.shardCount, 4);
+      expect(
+          HeadlessRenderOptions.fromArgs(
+              ['--headless-render', '--input=docs', '--shard=4/4']),
+          isNull);
+    });
+  });
+}
@@ -0,0 +1,177 @@
+// Pixel-equivalence harness: every tool and brush mode is rendered through
+// the reference path (SketchPainter(optimized: false): each stroke on its
+// own, fresh paints, no caches) and the optimized path, and the two images
+// must match within a perceptual tolerance.
+//
+// On a mismatch the reference, optimized and diff images are written to
+// build/painter_diffs/ (or PAINTER_DIFF_DIR); the diff shows the reference
+// in grey with every differing pixel in red.
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'package:professional_sketcher/utils/brush_textures.dart';
+import '../../benchmark/support/synthetic_strokes.dart';
+
+const Size _canvasSize = Size(480, 360);
+
+// A pixel differs when any channel moves more than this (of 255)...
+const int _channelTolerance = 24;
+// ...and a case fails when more than this share of the inked pixels do.
+const double _maxDifferingShare = 0.002;
+
+/// Difference between two RGBA renders of the same scene.
+class PixelDiff {
+  final int inked;
+  final int differing;
+  final Uint8List image;
+
+  const PixelDiff(this.inked, this.differing, this.image);
+
+  double get differingShare => inked == 0 ? 0.0 : differing / inked;
+
+  static PixelDiff compare(Uint8List reference, Uint8List candidate) {
+    final diff = Uint8List(reference.length);
+    int inked = 0;
+    int differing = 0;
+    for (int i = 0; i < reference.length; i += 4) {
+      int delta = 0;
+      for (int c = 0; c < 4; c++) {
+        final d = (reference[i + c] - candidate[i + c]).abs();
+        if (d > delta) delta = d;
+      }
+      if (reference[i + 3] != 0 || candidate[i + 3] != 0) inked++;
+      if (delta > _channelTolerance) {
+        differing++;
+        diff
+          ..[i] = 255
+          ..[i + 1] = 0
+          ..[i + 2] = 0
+          ..[i + 3] = 255;
+      } else {
+        final grey = 255 - reference[i + 3] ~/ 2;
+        diff
+          ..[i] = grey
+          ..[i + 1] = grey
+          ..[i + 2] = grey
+          ..[i + 3] = 255;
+      }
+    }
+    return PixelDiff(inked, differing, diff);
+  }
+}
+
+/// Pen strokes under the strokes of [tool], so erasers, blend modes and
+/// translucent brushes all act on existing ink. Two pen colors make the
+/// optimized path split batches.
+List<Stroke> _corpus(BenchTool tool) {
+  final background = [
+    for (int i = 0; i < 6; i++)
+      SyntheticStrokes.stroke(
+        const BenchTool(DrawingTool.pen),
+        pointCount: 60,
+        width: 3.0,
+        origin: Offset(12, 40.0 + i * 50),
+        variant: i,
+        color: i < 4 ? Colors.black : Colors.indigo,
+      ),
+  ];
+  final strokes = [
+    for (int i = 0; i < 5; i++)
+      SyntheticStrokes.stroke(
+        tool,
+        pointCount: i == 0 ? 1 : 20 + i * 15,
+        width: 6.0 + i * 5,
+        origin: Offset(30.0 + i * 12, 60.0 + i * 55),
+        variant: i + 10,
+        color: i.isEven ? Colors.teal : Colors.deepOrange,
+      ),
+  ];
+  return [...background, ...strokes];
+}
+
+Future<Uint8List> _render(List<Stroke> strokes, Stroke live,
+    {required bool optimized}) async {
+  final recorder = ui.PictureRecorder();
+  SketchPainter(
+    strokes: strokes,
+    currentStroke: live,
+    isImageVisible: false,
+    optimized: optimized,
+  ).paint(Canvas(recorder), _canvasSize);
+  final picture = recorder.endRecording();
+  final image = await picture.toImage(
+      _canvasSize.width.toInt(), _canvasSize.height.toInt());
+  picture.dispose();
+  try {
+    final data = await image.toByteData(format: ui.ImageByteFormat.rawRgba);
+    return data!.buffer.asUint8List();
+  } finally {
+    image.dispose();
+  }
+}
+
+Future<void> _writePng(String path, Uint8List rgba) async {
+  final completer = Completer<ui.Image>();
+  ui.decodeImageFromPixels(rgba, _canvasSize.width.toInt(),
+      _canvasSize.height.toInt(), ui.PixelFormat.rgba8888, completer.complete);
+  final image = await completer.future;
+  try {
+    final png = await image.toByteData(format: ui.ImageByteFormat.png);
+    final file = File(path)..parent.createSync(recursive: true);
+    file.writeAsBytesSync(png!.buffer.asUint8List());
+  } finally {
+    image.dispose();
+  }
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  group('SketchPainter pixel equivalence', () {
+    setUpAll(BrushTextures.load);
+
+    test('comparison flags only changes beyond the tolerance', () {
+      final reference = Uint8List(4 * 4)..fillRange(0, 16, 200);
+      final close = Uint8List.fromList(reference)..[0] = 200 - 10;
+      final far = Uint8List.fromList(reference)..[4] = 200 - 80;
+
+      expect(PixelDiff.compare(reference, close).differing, 0);
+      final diff = PixelDiff.compare(reference, far);
+      expect(diff.inked, 4);
+      expect(diff.differing, 1);
+      expect(diff.image.sublist(4, 8), [255, 0, 0, 255]);
+    });
+
+    for (final tool in BenchTool.all) {
+      test('optimized path matches reference for ${tool.name}', () async {
+        final strokes = _corpus(tool);
+        final live = SyntheticStrokes.stroke(tool,
+            pointCount: 40, width: 10.0, origin: const Offset(40, 320));
+
+        SketchPainter.clearStrokeCache();
+        final reference = await _render(strokes, live, optimized: false);
+        // Twice: the second frame runs on warm caches
+        await _render(strokes, live, optimized: true);
+        final optimized = await _render(strokes, live, optimized: true);
+
+        final diff = PixelDiff.compare(reference, optimized);
+        if (diff.differingShare > _maxDifferingShare) {
+          final dir = Platform.environment['PAINTER_DIFF_DIR'] ??
+              'build/painter_diffs';
+          await _writePng('$dir/${tool.name}.reference.png', reference);
+          await _writePng('$dir/${tool.name}.optimized.png', optimized);
+          await _writePng('$dir/${tool.name}.diff.png', diff.image);
+          fail('${diff.differing} of ${diff.inked} inked pixels differ '
+              '(${(diff.differingShare * 100).toStringAsFixed(2)}%); '
+              'see $dir/${tool.name}.diff.png');
+        }
+      });
+    }
+  });
+}
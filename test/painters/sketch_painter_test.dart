@@ -1,8 +1,12 @@
+import 'dart:ui' as ui;
 import 'package:flutter/material.dart';
 import 'package:flutter_test/flutter_test.dart';
+import 'package:get/get.dart';
 import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'package:professional_sketcher/models/sketch_layer.dart';
 import 'package:professional_sketcher/models/stroke.dart';
 import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/utils/image_tracker.dart';
 
 void main() {
   group('SketchPainter Tests', () {
@@ -624,5 +628,208 @@ void main() {
         expect(find.byType(CustomPaint), findsAtLeastNWidgets(1));
       });
     });
+
+    group('Stroke Batching Tests', () {
+      Stroke pen(double x,
+              {Color color = Colors.black,
+              double width = 2.0,
+              double opacity = 1.0}) =>
+          Stroke(
+            points: [
+              DrawingPoint(offset: Offset(x, 10), timestamp: 1),
+              DrawingPoint(offset: Offset(x + 5, 20), timestamp: 2),
+            ],
+            color: color,
+            width: width,
+            tool: DrawingTool.pen,
+            opacity: opacity,
+          );
+
+      Stroke eraser(double x) => Stroke(
+            points: [
+              DrawingPoint(offset: Offset(x, 10), timestamp: 1),
+              DrawingPoint(offset: Offset(x + 5, 20), timestamp: 2),
+            ],
+            color: Colors.transparent,
+            width: 10.0,
+            tool: DrawingTool.eraser,
+            isEraser: true,
+            blendMode: BlendMode.clear,
+          );
+
+      void paintAll(List<Stroke> strokes) {
+        final recorder = ui.PictureRecorder();
+        SketchPainter(strokes: strokes)
+            .paint(Canvas(recorder), const Size(400, 400));
+        recorder.endRecording().dispose();
+      }
+
+      test('should only batch opaque srcOver pen strokes', () {
+        expect(SketchPainter.isBatchable(pen(0)), isTrue);
+        expect(SketchPainter.isBatchable(pen(0, opacity: 0.5)), isFalse);
+        expect(SketchPainter.isBatchable(eraser(0)), isFalse);
+        expect(SketchPainter.isBatchable(testStrokes.first), isFalse);
+      });
+
+      test('should require identical paint settings to merge', () {
+        expect(SketchPainter.canBatchTogether(pen(0), pen(50)), isTrue);
+        expect(
+            SketchPainter.canBatchTogether(pen(0), pen(50, color: Colors.red)),
+            isFalse);
+        expect(SketchPainter.canBatchTogether(pen(0), pen(50, width: 4.0)),
+            isFalse);
+      });
+
+      test('should collapse many compatible pen strokes into one draw', () {
+        paintAll(List.generate(1000, (i) => pen(i * 0.3)));
+        expect(SketchPainter.lastPenBatchCount, 1);
+      });
+
+      test('should split batches at eraser and style boundaries', () {
+        paintAll([
+          pen(0),
+          pen(10),
+          eraser(5),
+          pen(20),
+          pen(30, color: Colors.red),
+          pen(40, color: Colors.red),
+        ]);
+        expect(SketchPainter.lastPenBatchCount, 3);
+      });
+    });
+
+    group('Layer Compositing Tests', () {
+      const size = Size(40, 40);
+
+      Stroke line(double y, {bool erase = false}) => Stroke(
+            points: [
+              DrawingPoint(offset: Offset(0, y), timestamp: 1),
+              DrawingPoint(offset: Offset(40, y), timestamp: 2),
+            ],
+            color: erase ? Colors.transparent : Colors.black,
+            width: 10.0,
+            tool: erase ? DrawingTool.eraser : DrawingTool.pen,
+            isEraser: erase,
+            blendMode: erase ? BlendMode.clear : BlendMode.srcOver,
+          );
+
+      SketchLayer layer(int id, List<Stroke> strokes) =>
+          SketchLayer(id: id, name: 'Layer $id', strokes: strokes.obs);
+
+      void paintLayers(List<SketchLayer> layers, int active) {
+        final recorder = ui.PictureRecorder();
+        SketchPainter(
+          strokes: layers[active].strokes,
+          layers: layers,
+          activeLayer: active,
+        ).paint(Canvas(recorder), size);
+        recorder.endRecording().dispose();
+      }
+
+      Future<int> alphaAt(SketchPainter painter, Offset at) async {
+        final recorder = ui.PictureRecorder();
+        painter.paint(Canvas(recorder), size);
+        final picture = recorder.endRecording();
+        final image = await picture.toImage(40, 40);
+        picture.dispose();
+        final data = await image.toByteData();
+        image.dispose();
+        final offset = (at.dy.toInt() * 40 + at.dx.toInt()) * 4;
+        return data!.getUint8(offset + 3);
+      }
+
+      setUp(() {
+        ImageTracker.reset();
+        SketchPainter.clearStrokeCache();
+      });
+
+      tearDown(() {
+        SketchPainter.clearLayerPictures();
+        expect(ImageTracker.leaks(), isEmpty,
+            reason: ImageTracker.describeLeaks());
+      });
+
+      test('should record each inactive layer once', () {
+        final layers = [layer(0, [line(10)]), layer(1, [line(30)])];
+
+        paintLayers(layers, 1);
+        paintLayers(layers, 1);
+
+        expect(SketchPainter.cachedLayerCount, 1);
+        expect(SketchPainter.stats.cachedLayers, 1);
+        expect(ImageTracker.livePictures, 1);
+      });
+
+      test('should re-record a layer when its revision moves on', () {
+        final bottom = layer(0, [line(10)]);
+        paintLayers([bottom, layer(1, [])], 1);
+        final first = ImageTracker.live.single.resource as ui.Picture;
+
+        paintLayers([bottom.touched(), layer(1, [])], 1);
+
+        expect(first.debugDisposed, isTrue);
+        expect(ImageTracker.livePictures, 1);
+      });
+
+      test('should skip hidden layers and drop the active layer picture', () {
+        final bottom = layer(0, [line(10)]);
+        final top = layer(1, [line(30)]);
+        paintLayers([bottom.copyWith(visible: false), top], 1);
+        expect(SketchPainter.stats.cachedLayers, 0);
+        expect(SketchPainter.cachedLayerCount, 0);
+
+        paintLayers([bottom, top], 1);
+        paintLayers([bottom, top], 0);
+        expect(SketchPainter.cachedLayerCount, 1);
+        expect(ImageTracker.livePictures, 1);
+      });
+
+      test('should keep an eraser to its own layer', () async {
+        final ink = line(20);
+        final eraser = line(20, erase: true);
+
+        final flat = SketchPainter(strokes: [ink, eraser]);
+        expect(await alphaAt(flat, const Offset(20, 20)), 0);
+
+        final layered = SketchPainter(
+          strokes: [eraser],
+          layers: [layer(0, [ink]), layer(1, [eraser])],
+          activeLayer: 1,
+        );
+        expect(await alphaAt(layered, const Offset(20, 20)), 255);
+      });
+
+      test('should apply layer opacity when compositing', () async {
+        final painter = SketchPainter(
+          strokes: const <Stroke>[],
+          layers: [
+            layer(0, [line(20)]).copyWith(opacity: 0.5),
+            layer(1, []),
+          ],
+          activeLayer: 1,
+        );
+        expect(await alphaAt(painter, const Offset(20, 20)), closeTo(128, 2));
+      });
+
+      test('should repaint when a layer is replaced', () {
+        final layers = [layer(0, [line(10)]), layer(1, [])];
+        final strokes = layers[1].strokes;
+        final before = SketchPainter(
+            strokes: strokes, layers: layers, activeLayer: 1);
+        final same = SketchPainter(
+            strokes: strokes, layers: List.of(layers), activeLayer: 1);
+        final changed = SketchPainter(
+          strokes: strokes,
+          layers: [
+            layers[0].copyWith(blendMode: BlendMode.multiply),
+            layers[1],
+          ],
+          activeLayer: 1,
+        );
+
+        expect(same.shouldRepaint(before), isFalse);
+        expect(changed.shouldRepaint(before), isTrue);
+      });
+    });
   });
 }
@@ -0,0 +1,92 @@
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/brush_mode.dart';
+import 'package:professional_sketcher/painters/stroke_paints.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  group('StrokePaints Tests', () {
+    Stroke strokeFor(DrawingTool tool,
+            {Color color = Colors.black, BrushMode? mode}) =>
+        Stroke(
+          points: [
+            DrawingPoint(offset: const Offset(0, 0), timestamp: 1),
+            DrawingPoint(offset: const Offset(10, 10), timestamp: 2),
+          ],
+          color: color,
+          width: 6.0,
+          tool: tool,
+          opacity: 0.8,
+          brushMode: mode,
+        );
+
+    test('should build paints for every tool and brush mode', () {
+      for (final tool in DrawingTool.values) {
+        final paints = StrokePaints.forStroke(strokeFor(tool));
+        expect(paints.base, isA<Paint>());
+        expect(paints.texture, isA<Paint>());
+        expect(paints.edge, isA<Paint>());
+        expect(paints.glow, isA<Paint>());
+      }
+      for (final mode in BrushMode.values) {
+        final paints =
+            StrokePaints.forStroke(strokeFor(DrawingTool.brush, mode: mode));
+        expect(paints.base, isA<Paint>());
+      }
+    });
+
+    test('pencil texture should darken on bright colors', () {
+      final bright = StrokePaints.forStroke(
+          strokeFor(DrawingTool.pencil, color: Colors.white));
+      expect(bright.textureColor, Colors.black.withValues(alpha: 0.12));
+
+      final dark = StrokePaints.forStroke(
+          strokeFor(DrawingTool.pencil, color: Colors.black));
+      expect(dark.textureColor.a, closeTo(0.8 * 0.18, 1e-6));
+    });
+
+    test('eraser paints should punch out with dstOut', () {
+      final paints = StrokePaints.forStroke(strokeFor(DrawingTool.eraser));
+      expect(paints.base.blendMode, BlendMode.dstOut);
+      expect(paints.edge.blendMode, BlendMode.dstOut);
+      expect(paints.edge.strokeWidth, closeTo(9.0, 1e-6));
+    });
+
+    test('calligraphy paints should use butt caps', () {
+      final paints = StrokePaints.forStroke(
+          strokeFor(DrawingTool.brush, mode: BrushMode.calligraphy));
+      expect(paints.base.strokeCap, StrokeCap.butt);
+      expect(paints.edge.strokeCap, StrokeCap.butt);
+    });
+
+    test('grain should take the alpha and style of every call', () {
+      final recorder = ui.PictureRecorder();
+      Canvas(recorder).drawRect(const Rect.fromLTWH(0, 0, 4, 4), Paint());
+      final picture = recorder.endRecording();
+      final image = picture.toImageSync(4, 4);
+      final identity = Float64List(16)
+        ..[0] = 1.0
+        ..[5] = 1.0
+        ..[10] = 1.0
+        ..[15] = 1.0;
+      final shader = ImageShader(
+          image, TileMode.repeated, TileMode.repeated, identity);
+      final paints = StrokePaints.forStroke(strokeFor(DrawingTool.pencil));
+
+      final first = paints.grain(shader, alpha: 0.4);
+      final second =
+          paints.grain(shader, alpha: 0.2, style: PaintingStyle.stroke);
+
+      expect(second, same(first));
+      expect(second.color.a, closeTo(0.2, 1 / 255));
+      expect(second.style, PaintingStyle.stroke);
+      image.dispose();
+      picture.dispose();
+    });
+  });
+}
@@ -0,0 +1,32 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/utils/benchmark_mode.dart';
+import 'package:professional_sketcher/utils/input_replayer.dart';
+
+void main() {
+  group('BenchmarkOptions Tests', () {
+    test('should stay off without --benchmark', () {
+      expect(BenchmarkOptions.fromArgs(const []), isNull);
+      expect(BenchmarkOptions.fromArgs(const ['--benchmark-out=a.json']),
+          isNull);
+      expect(BenchmarkOptions.fromArgs(const ['--benchmark=']), isNull);
+    });
+
+    test('should parse session, output and speed', () {
+      final options = BenchmarkOptions.fromArgs(const [
+        '--benchmark=/tmp/session.skis',
+        '--benchmark-out=/tmp/out.json',
+        '--benchmark-speed=recorded',
+      ])!;
+      expect(options.sessionPath, '/tmp/session.skis');
+      expect(options.outPath, '/tmp/out.json');
+      expect(options.speed, ReplaySpeed.recorded);
+    });
+
+    test('should default output and replay at max speed', () {
+      final options =
+          BenchmarkOptions.fromArgs(const ['--benchmark=session.skis'])!;
+      expect(options.outPath, 'benchmark-results.json');
+      expect(options.speed, ReplaySpeed.max);
+    });
+  });
+}
@@ -0,0 +1,98 @@
+import 'dart:io';
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/brush_mode.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'package:professional_sketcher/utils/brush_textures.dart';
+
+/// The Linux runner embeds these; regenerate them after changing the
+/// generator with `UPDATE_BRUSH_TEXTURES=true flutter test <this file>`.
+const _assetDir = 'linux/runner/resources/brush_textures';
+const _assetNames = {
+  BrushTexture.pencilPaper: 'pencil_paper.r8',
+  BrushTexture.charcoalGrain: 'charcoal_grain.r8',
+  BrushTexture.pastelGrain: 'pastel_grain.r8',
+};
+
+/// A 12 px wide horizontal stroke along y = 20.
+Stroke _stroke(DrawingTool tool, BrushMode? mode) => Stroke(
+      points: [
+        for (int i = 0; i < 10; i++)
+          DrawingPoint(offset: Offset(i * 8.0, 20), timestamp: i * 16.0),
+      ],
+      color: Colors.brown,
+      width: 12,
+      tool: tool,
+      brushMode: mode,
+    );
+
+void main() {
+  group('BrushTextures Tests', () {
+    test('should match the textures embedded in the Linux runner', () {
+      final update = Platform.environment['UPDATE_BRUSH_TEXTURES'] == 'true';
+      for (final texture in BrushTexture.values) {
+        final file = File('$_assetDir/${_assetNames[texture]}');
+        final tile = BrushTextures.synthesize(texture);
+        if (update) file.writeAsBytesSync(tile);
+        expect(file.readAsBytesSync(), tile, reason: texture.name);
+      }
+    });
+
+    test('should synthesize full tiles with visible grain', () {
+      for (final texture in BrushTexture.values) {
+        final tile = BrushTextures.tile(texture);
+        expect(tile, hasLength(BrushTextures.edge * BrushTextures.edge));
+        final mean = tile.fold<int>(0, (a, b) => a + b) / tile.length;
+        expect(mean, inInclusiveRange(20, 160), reason: texture.name);
+      }
+    });
+
+    testWidgets('should paint textured brushes once loaded', (tester) async {
+      await tester.runAsync(BrushTextures.load);
+      for (final texture in BrushTexture.values) {
+        expect(BrushTextures.shader(texture), isNotNull);
+      }
+
+      final recorder = ui.PictureRecorder();
+      SketchPainter(strokes: [
+        _stroke(DrawingTool.pencil, null),
+        _stroke(DrawingTool.brush, BrushMode.charcoal),
+        _stroke(DrawingTool.brush, BrushMode.pastel),
+      ], isImageVisible: false)
+          .paint(Canvas(recorder), const Size(100, 50));
+      recorder.endRecording().dispose();
+      SketchPainter.clearStrokeCache();
+    });
+
+    testWidgets('should keep textured charcoal inside its dabs',
+        (tester) async {
+      await tester.runAsync(BrushTextures.load);
+      final recorder = ui.PictureRecorder();
+      SketchPainter(strokes: [
+        _stroke(DrawingTool.brush, BrushMode.charcoal),
+      ], isImageVisible: false)
+          .paint(Canvas(recorder), const Size(100, 50));
+      final picture = recorder.endRecording();
+      final pixels = (await tester.runAsync(() async {
+        final image = await picture.toImage(100, 50);
+        final data = await image.toByteData();
+        image.dispose();
+        return data;
+      }))!;
+      picture.dispose();
+      SketchPainter.clearStrokeCache();
+
+      // Dabs reach 6 px either side of the line; allow 1 px of antialiasing
+      for (int y = 0; y < 50; y++) {
+        if ((y + 0.5 - 20).abs() <= 7) continue;
+        for (int x = 0; x < 100; x++) {
+          expect(pixels.getUint8((y * 100 + x) * 4 + 3), 0,
+              reason: 'ink at ($x, $y)');
+        }
+      }
+    });
+  });
+}
@@ -0,0 +1,101 @@
+import 'dart:convert';
+import 'dart:io';
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:get/get.dart';
+import 'package:professional_sketcher/controllers/sketch_controller.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/sketch_document.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/utils/document_channel.dart';
+
+/// Writes a document whose strokes are dots at [dots] and returns its path.
+String _writeDocument(Directory dir, String name, List<Offset> dots) {
+  final document = SketchDocument(
+    canvasSize: const Size(100, 100),
+    strokes: [
+      for (final dot in dots)
+        Stroke(
+          points: [DrawingPoint(offset: dot, timestamp: 0)],
+          color: Colors.black,
+          width: 2.0,
+          tool: DrawingTool.pen,
+        ),
+    ],
+  );
+  final file = File('${dir.path}/$name')
+    ..writeAsStringSync(jsonEncode(document.toJson()));
+  return file.path;
+}
+
+List<Offset> _dots(SketchController controller) =>
+    [for (final stroke in controller.allStrokes) stroke.points.first.offset];
+
+void main() {
+  group('DocumentChannel Tests', () {
+    late SketchController controller;
+    late Directory dir;
+
+    setUp(() {
+      Get.testMode = true;
+      controller = SketchController();
+      dir = Directory.systemTemp.createTempSync('document_channel_test');
+    });
+
+    tearDown(() {
+      dir.deleteSync(recursive: true);
+      Get.reset();
+    });
+
+    test('should open two paths in a row as separate undo steps', () async {
+      controller.startStroke(const Offset(5, 5), 1.0);
+      controller.endStroke();
+      final first = _writeDocument(dir, 'first.json', [const Offset(1, 1)]);
+      final second = _writeDocument(
+          dir, 'second.json', [const Offset(2, 2), const Offset(3, 3)]);
+      final asked = <String>[];
+      Future<bool> confirm(String path) async {
+        asked.add(path);
+        return true;
+      }
+
+      // Forwarded paths arrive without waiting for each other
+      final opened = await Future.wait([
+        DocumentChannel.open(first, controller, confirm: confirm),
+        DocumentChannel.open(second, controller, confirm: confirm),
+      ]);
+
+      expect(opened, [true, true]);
+      expect(asked, [first, second]);
+      expect(_dots(controller), [const Offset(2, 2), const Offset(3, 3)]);
+
+      controller.undo();
+      expect(_dots(controller), [const Offset(1, 1)]);
+
+      controller.undo();
+      expect(_dots(controller), [const Offset(5, 5)]);
+    });
+
+    test('should keep the drawing when the open is declined', () async {
+      controller.startStroke(const Offset(5, 5), 1.0);
+      controller.endStroke();
+      final path = _writeDocument(dir, 'doc.json', [const Offset(1, 1)]);
+
+      final opened = await DocumentChannel.open(path, controller,
+          confirm: (_) async => false);
+
+      expect(opened, isFalse);
+      expect(_dots(controller), [const Offset(5, 5)]);
+    });
+
+    test('should open onto an empty canvas without asking', () async {
+      final path = _writeDocument(dir, 'doc.json', [const Offset(1, 1)]);
+
+      final opened = await DocumentChannel.open(path, controller,
+          confirm: (_) async => fail('asked with nothing to replace'));
+
+      expect(opened, isTrue);
+      expect(_dots(controller), [const Offset(1, 1)]);
+    });
+  });
+}
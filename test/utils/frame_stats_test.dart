@@ -0,0 +1,42 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/utils/frame_stats.dart';
+
+void main() {
+  group('RollingFrameStats Tests', () {
+    test('should report zero with no samples', () {
+      final stats = RollingFrameStats();
+      expect(stats.sampleCount, 0);
+      expect(stats.buildMs(50), 0.0);
+      expect(stats.rasterMs(99), 0.0);
+    });
+
+    test('should compute nearest-rank percentiles in milliseconds', () {
+      final stats = RollingFrameStats(capacity: 100);
+      for (int i = 1; i <= 100; i++) {
+        stats.addSample(i * 1000.0, i * 2000.0);
+      }
+      expect(stats.buildMs(50), 50.0);
+      expect(stats.buildMs(95), 95.0);
+      expect(stats.buildMs(99), 99.0);
+      expect(stats.rasterMs(50), 100.0);
+      expect(stats.rasterMs(100), 200.0);
+    });
+
+    test('should only keep the most recent window', () {
+      final stats = RollingFrameStats(capacity: 4);
+      for (final v in [100.0, 100.0, 100.0, 100.0, 1.0, 2.0, 3.0, 4.0]) {
+        stats.addSample(v * 1000, 0);
+      }
+      expect(stats.sampleCount, 4);
+      expect(stats.buildMs(100), 4.0);
+      expect(stats.buildMs(25), 1.0);
+    });
+
+    test('clear should drop all samples', () {
+      final stats = RollingFrameStats(capacity: 8)..addSample(5000, 5000);
+      stats.clear();
+      expect(stats.sampleCount, 0);
+      expect(stats.buildMs(50), 0.0);
+    });
+  });
+}
@@ -0,0 +1,96 @@
+import 'dart:ui' as ui;
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/sketch_document.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/utils/headless_render.dart';
+import 'package:professional_sketcher/utils/image_tracker.dart';
+
+ui.Picture _recordDot() {
+  final recorder = ui.PictureRecorder();
+  Canvas(recorder).drawCircle(const Offset(8, 8), 4, Paint());
+  return recorder.endRecording();
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  group('ImageTracker Tests', () {
+    setUp(ImageTracker.reset);
+
+    test('should count live pictures and images with their size', () {
+      final picture = ImageTracker.picture(_recordDot(), 'test.picture');
+      final image =
+          ImageTracker.image(picture.toImageSync(16, 8), 'test.image');
+
+      expect(ImageTracker.livePictures, 1);
+      expect(ImageTracker.liveImages, 1);
+      expect(ImageTracker.liveImageBytes, 16 * 8 * 4);
+      expect(ImageTracker.livePictureBytes, greaterThan(0));
+
+      picture.dispose();
+      image.dispose();
+      expect(ImageTracker.live, isEmpty);
+    });
+
+    test('should report undisposed resources as leaks by site', () {
+      final picture = _recordDot();
+      final leaked = ImageTracker.image(picture.toImageSync(4, 4), 'leaky');
+      final kept = ImageTracker.image(picture.toImageSync(4, 4), 'tidy');
+      picture.dispose();
+      kept.dispose();
+
+      expect(ImageTracker.leaks().map((e) => e.site), ['leaky']);
+      expect(ImageTracker.leaks(site: 'tidy'), isEmpty);
+      expect(ImageTracker.describeLeaks(), contains('Image from leaky'));
+      leaked.dispose();
+    });
+
+    test('should drop disposed entries when registering', () {
+      final first = ImageTracker.picture(_recordDot(), 'first');
+      first.dispose();
+      final second = ImageTracker.picture(_recordDot(), 'second');
+
+      expect(ImageTracker.registered, 1);
+      expect(ImageTracker.live.single.resource, same(second));
+      expect(ImageTracker.collected, isEmpty);
+      second.dispose();
+    });
+
+    test('should not count permanent images as leaks', () {
+      final picture = _recordDot();
+      final texture = ImageTracker.image(
+          picture.toImageSync(4, 4), 'texture',
+          permanent: true);
+      picture.dispose();
+
+      expect(ImageTracker.liveImages, 1);
+      expect(ImageTracker.leaks(), isEmpty);
+      texture.dispose();
+    });
+
+    test('should leave nothing live after rendering a document', () async {
+      final document = SketchDocument(
+        canvasSize: const Size(64, 64),
+        strokes: [
+          Stroke(
+            points: [
+              DrawingPoint(offset: const Offset(4, 4), timestamp: 0),
+              DrawingPoint(offset: const Offset(60, 60), timestamp: 16),
+            ],
+            color: Colors.black,
+            width: 3.0,
+            tool: DrawingTool.pen,
+          ),
+        ],
+      );
+
+      final png = await renderDocumentPng(document);
+
+      expect(png, isNotEmpty);
+      expect(ImageTracker.leaks(), isEmpty,
+          reason: ImageTracker.describeLeaks());
+    });
+  });
+}
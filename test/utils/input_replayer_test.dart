@@ -0,0 +1,136 @@
+import 'package:flutter/gestures.dart';
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:get/get.dart';
+import 'package:professional_sketcher/controllers/sketch_controller.dart';
+import 'package:professional_sketcher/models/brush_mode.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/eraser_mode.dart';
+import 'package:professional_sketcher/models/input_session.dart';
+import 'package:professional_sketcher/utils/input_recorder.dart';
+import 'package:professional_sketcher/utils/input_replayer.dart';
+
+void main() {
+  group('Input Record/Replay Tests', () {
+    late SketchController controller;
+
+    setUp(() {
+      Get.testMode = true;
+      controller = SketchController();
+    });
+
+    tearDown(() {
+      Get.reset();
+    });
+
+    InputSession recordSession() {
+      final recorder = InputRecorder()..start(const Size(400, 300));
+      recorder.recordTool(DrawingTool.brush);
+      recorder.recordBrushMode(BrushMode.pastel);
+      recorder.recordBrushSize(12.0);
+      recorder.recordPointer(
+          const PointerDownEvent(pointer: 1, position: Offset(10, 10)), 0);
+      for (int i = 1; i <= 5; i++) {
+        recorder.recordPointer(
+            PointerMoveEvent(pointer: 1, position: Offset(10.0 + i * 10, 10)),
+            1);
+      }
+      recorder.recordPointer(
+          const PointerUpEvent(pointer: 1, position: Offset(60, 10)), 1);
+      return recorder.stop();
+    }
+
+    test('recorder should capture pointer and setting events in order', () {
+      final session = recordSession();
+
+      expect(session.canvasSize, const Size(400, 300));
+      expect(session.events.length, 3 + 7);
+      expect(session.events[3].type, InputEventType.down);
+      expect(session.events.last.type, InputEventType.up);
+      expect(session.strokeCount, 1);
+      for (int i = 1; i < session.events.length; i++) {
+        expect(session.events[i].timeMicros,
+            greaterThanOrEqualTo(session.events[i - 1].timeMicros));
+      }
+    });
+
+    test('recorder should ignore events while stopped', () {
+      final recorder = InputRecorder();
+      recorder.recordTool(DrawingTool.pen);
+      recorder.recordPointer(const PointerDownEvent(), 0);
+      expect(recorder.eventCount, 0);
+    });
+
+    test('replayer should apply settings and feed pointers in order',
+        () async {
+      final session = InputSession.fromBytes(recordSession().toBytes());
+      final received = <PointerEvent>[];
+      var frames = 0;
+
+      await InputReplayer(
+        session: session,
+        controller: controller,
+        onPointer: received.add,
+        speed: ReplaySpeed.max,
+        nextFrame: () async => frames++,
+      ).run();
+
+      expect(controller.currentTool.value, DrawingTool.brush);
+      expect(controller.currentBrushMode.value, BrushMode.pastel);
+      expect(controller.brushSize.value, 12.0);
+      expect(received.length, 7);
+      expect(received.first, isA<PointerDownEvent>());
+      expect(received.last, isA<PointerUpEvent>());
+      expect(received[3].localPosition, const Offset(40, 10));
+      expect(frames, 7);
+    });
+
+    test('replayer should apply eraser, lasso and layer changes', () async {
+      final recorder = InputRecorder()..start(const Size(400, 300));
+      recorder.recordEraserMode(EraserMode.object);
+      recorder.recordLassoMode(true);
+      recorder.recordLayer(InputEventType.addLayer);
+      recorder.recordLayer(InputEventType.addLayer);
+      recorder.recordLayer(InputEventType.layerOpacity, index: 1, value: 0.5);
+      recorder.recordLayer(InputEventType.layerVisible, index: 2);
+      recorder.recordLayer(InputEventType.layerBlendMode,
+          index: 1, value: BlendMode.multiply.index.toDouble());
+      recorder.recordLayer(InputEventType.removeLayer, index: 0);
+      recorder.recordLayer(InputEventType.activeLayer, index: 0);
+      final session = InputSession.fromBytes(recorder.stop().toBytes());
+
+      await InputReplayer(
+        session: session,
+        controller: controller,
+        onPointer: (_) {},
+        speed: ReplaySpeed.max,
+        nextFrame: () async {},
+      ).run();
+
+      expect(controller.eraserMode.value, EraserMode.object);
+      expect(controller.lassoMode.value, isTrue);
+      expect(controller.layers.length, 2);
+      expect(controller.activeLayerIndex.value, 0);
+      expect(controller.layers[0].opacity, 0.5);
+      expect(controller.layers[0].blendMode, BlendMode.multiply);
+      expect(controller.layers[1].visible, isFalse);
+    });
+
+    test('replayer should stop when cancelled', () async {
+      final received = <PointerEvent>[];
+      late InputReplayer replayer;
+      replayer = InputReplayer(
+        session: recordSession(),
+        controller: controller,
+        onPointer: (event) {
+          received.add(event);
+          if (received.length == 2) replayer.cancel();
+        },
+        speed: ReplaySpeed.max,
+        nextFrame: () async {},
+      );
+      await replayer.run();
+      expect(received.length, 2);
+    });
+  });
+}
@@ -0,0 +1,70 @@
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/utils/lasso.dart';
+
+Stroke _stroke(List<Offset> offsets) {
+  return Stroke(
+    points: [
+      for (final offset in offsets)
+        DrawingPoint(offset: offset, timestamp: 0),
+    ],
+    color: Colors.black,
+    width: 2.0,
+    tool: DrawingTool.pen,
+  );
+}
+
+void main() {
+  group('Lasso Tests', () {
+    const square = [
+      Offset(0, 0),
+      Offset(100, 0),
+      Offset(100, 100),
+      Offset(0, 100),
+    ];
+
+    test('should tell points inside a polygon from those outside', () {
+      expect(Lasso.contains(square, const Offset(50, 50)), isTrue);
+      expect(Lasso.contains(square, const Offset(150, 50)), isFalse);
+      expect(Lasso.contains(square, const Offset(50, -1)), isFalse);
+    });
+
+    test('should handle concave lassos', () {
+      const notch = [
+        Offset(0, 0),
+        Offset(100, 0),
+        Offset(100, 100),
+        Offset(50, 20),
+        Offset(0, 100),
+      ];
+
+      expect(Lasso.contains(notch, const Offset(50, 10)), isTrue);
+      expect(Lasso.contains(notch, const Offset(50, 60)), isFalse);
+    });
+
+    test('should select strokes with at least half their points inside', () {
+      final inside = _stroke(const [Offset(10, 10), Offset(90, 90)]);
+      final half = _stroke(const [Offset(50, 50), Offset(150, 50)]);
+      final mostlyOut = _stroke(const [
+        Offset(90, 50),
+        Offset(150, 50),
+        Offset(200, 50),
+      ]);
+      final outside = _stroke(const [Offset(200, 200), Offset(300, 300)]);
+
+      final selected =
+          Lasso.select([inside, half, mostlyOut, outside], square);
+
+      expect(selected, [inside, half]);
+    });
+
+    test('should select nothing with fewer than three lasso points', () {
+      final stroke = _stroke(const [Offset(10, 10), Offset(20, 20)]);
+
+      expect(Lasso.select([stroke], const [Offset(0, 0), Offset(50, 50)]),
+          isEmpty);
+    });
+  });
+}
@@ -0,0 +1,48 @@
+import 'dart:ui';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/utils/runner_metrics.dart';
+
+void main() {
+  group('RunnerMetrics Tests', () {
+    test('should be disabled outside the Linux runner', () {
+      expect(RunnerMetrics.enabled, isFalse);
+    });
+
+    test('should accept updates as no-ops when disabled', () {
+      RunnerMetrics.add(MetricCounter.frames);
+      RunnerMetrics.set(MetricGauge.strokeCount, 10);
+      RunnerMetrics.record(MetricHistogram.endStrokeUs, 1500);
+      RunnerMetrics.recordFrameTimings([
+        FrameTiming(
+          vsyncStart: 0,
+          buildStart: 0,
+          buildFinish: 1000,
+          rasterStart: 1000,
+          rasterFinish: 3000,
+          rasterFinishWallTime: 3000,
+        ),
+      ]);
+    });
+
+    test('should keep ids in the order of linux/runner/metrics.h', () {
+      expect(MetricCounter.values.map((c) => c.name), [
+        'frames',
+        'strokesCommitted',
+        'paintCacheHits',
+        'paintCacheMisses',
+        'exports',
+        'inputEvents',
+        'uiStalls',
+      ]);
+      expect(MetricGauge.values.map((g) => g.name),
+          ['strokeCount', 'cachedImageBytes', 'rssBytes']);
+      expect(MetricHistogram.values.map((h) => h.name), [
+        'frameBuildUs',
+        'frameRasterUs',
+        'endStrokeUs',
+        'exportUs',
+        'uiStallUs',
+      ]);
+    });
+  });
+}
@@ -0,0 +1,55 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/utils/sketch_log.dart';
+
+void main() {
+  group('SketchLog Tests', () {
+    setUp(() {
+      SketchLog.clear();
+      SketchLog.echo = false;
+    });
+
+    test('should be compiled out by default', () {
+      expect(kSketchLog, isFalse);
+    });
+
+    test('should capture structured entries oldest first', () {
+      SketchLog.log('pointer', 'down', {'pointers': 0});
+      SketchLog.log('undo', 'called', {'strokes': 3});
+
+      final entries = SketchLog.entries;
+      expect(entries.length, 2);
+      expect(entries[0].tag, 'pointer');
+      expect(entries[0].fields, {'pointers': 0});
+      expect(entries[1].tag, 'undo');
+      expect(entries[1].timeMicros,
+          greaterThanOrEqualTo(entries[0].timeMicros));
+    });
+
+    test('should keep only the most recent entries when full', () {
+      for (int i = 0; i < SketchLog.capacity + 10; i++) {
+        SketchLog.log('repaint', 'frame $i');
+      }
+      final entries = SketchLog.entries;
+      expect(entries.length, SketchLog.capacity);
+      expect(entries.first.message, 'frame 10');
+      expect(entries.last.message, 'frame ${SketchLog.capacity + 9}');
+    });
+
+    test('should dump entries as text filtered by tag', () {
+      SketchLog.log('repaint', 'stroke count changed', {'from': 1, 'to': 2});
+      SketchLog.log('undo', 'called');
+
+      final dump = SketchLog.dump(tag: 'repaint');
+      expect(dump, contains('repaint: stroke count changed from=1 to=2'));
+      expect(dump, isNot(contains('undo')));
+      expect(SketchLog.dump().split('\n').length, 2);
+    });
+
+    test('should clear captured entries', () {
+      SketchLog.log('pointer', 'up');
+      SketchLog.clear();
+      expect(SketchLog.entries, isEmpty);
+      expect(SketchLog.dump(), isEmpty);
+    });
+  });
+}
@@ -0,0 +1,36 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/brush_mode.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/utils/stall_watchdog.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  group('StallWatchdog Tests', () {
+    test('should be disabled outside the Linux runner', () {
+      expect(StallWatchdog.enabled, isFalse);
+    });
+
+    test('should accept calls as no-ops when disabled', () {
+      StallWatchdog.start();
+      StallWatchdog.note(StrokeOp.addPoint,
+          strokes: 12,
+          points: 40,
+          tool: DrawingTool.brush,
+          brushMode: BrushMode.watercolor);
+    });
+
+    test('should keep ops in the order of linux/runner/watchdog.h', () {
+      expect(StrokeOp.values.map((op) => op.name), [
+        'none',
+        'startStroke',
+        'addPoint',
+        'endStroke',
+        'undo',
+        'clear',
+        'loadDocument',
+        'export',
+      ]);
+    });
+  });
+}
@@ -0,0 +1,50 @@
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/utils/startup_trace.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+  const channel = MethodChannel('sketcher/startup');
+
+  group('StartupTrace Tests', () {
+    final calls = <MethodCall>[];
+
+    setUp(() {
+      calls.clear();
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        calls.add(call);
+        return null;
+      });
+    });
+
+    tearDown(() {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, null);
+    });
+
+    test('should send a mark with its timestamp', () async {
+      StartupTrace.mark('dart_main', 1234);
+      await pumpEventQueue();
+      expect(calls, hasLength(1));
+      expect(calls.single.method, 'mark');
+      expect(calls.single.arguments, {'name': 'dart_main', 'ts': 1234});
+    });
+
+    test('should report only the first paint', () async {
+      StartupTrace.firstPaint();
+      StartupTrace.firstPaint();
+      await pumpEventQueue();
+      expect(calls.map((c) => (c.arguments as Map)['name']),
+          ['dart_first_paint']);
+    });
+
+    test('should ignore a missing runner channel', () async {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, null);
+      StartupTrace.mark('orphan');
+      await pumpEventQueue();
+      expect(calls, isEmpty);
+    });
+  });
+}
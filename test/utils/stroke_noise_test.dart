@@ -0,0 +1,92 @@
+import 'dart:typed_data';
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/utils/stroke_noise.dart';
+
+void main() {
+  group('StrokeNoise Tests', () {
+    test('should be deterministic for the same coordinates', () {
+      expect(StrokeNoise.unit(42, 7, 3), StrokeNoise.unit(42, 7, 3));
+      expect(StrokeNoise.hash(1, 2, 3), StrokeNoise.hash(1, 2, 3));
+    });
+
+    test('should not depend on evaluation order', () {
+      final forward = [for (int i = 0; i < 50; i++) StrokeNoise.unit(9, i, 0)];
+      final backward = [
+        for (int i = 49; i >= 0; i--) StrokeNoise.unit(9, i, 0)
+      ].reversed.toList();
+      expect(forward, backward);
+    });
+
+    test('should stay within [0, 1) and be roughly uniform', () {
+      double sum = 0;
+      const n = 10000;
+      for (int i = 0; i < n; i++) {
+        final v = StrokeNoise.unit(123, i, i % 7);
+        expect(v, greaterThanOrEqualTo(0.0));
+        expect(v, lessThan(1.0));
+        sum += v;
+      }
+      expect(sum / n, closeTo(0.5, 0.02));
+    });
+
+    test('should vary with seed, index and k', () {
+      final base = StrokeNoise.hash(5, 5, 5);
+      expect(StrokeNoise.hash(6, 5, 5), isNot(base));
+      expect(StrokeNoise.hash(5, 6, 5), isNot(base));
+      expect(StrokeNoise.hash(5, 5, 6), isNot(base));
+    });
+
+    test('fill should match per-value lookups', () {
+      final out = Float32List(8);
+      StrokeNoise.fill(out, 77, 12, 4);
+      for (int j = 0; j < out.length; j++) {
+        expect(out[j], closeTo(StrokeNoise.unit(77, 12, 4 + j), 1e-6));
+      }
+    });
+
+    test('fill should stay below 1.0 in float32', () {
+      // Hashes to 2^32 - 119, which rounds to 1.0 as a float32
+      const k = 26532579;
+      expect(StrokeNoise.hash(1, 0, k), 4294967177);
+
+      final out = Float32List(1);
+      StrokeNoise.fill(out, 1, 0, k);
+      expect(out[0], lessThan(1.0));
+      expect(out[0], closeTo(StrokeNoise.unit(1, 0, k), 1e-6));
+    });
+
+    test('live and smoothed committed stroke should share a seed', () {
+      final first = DrawingPoint(offset: const Offset(10, 20), timestamp: 1e12);
+      final live = Stroke(
+        points: [
+          first,
+          DrawingPoint(offset: const Offset(15, 25), timestamp: 1e12 + 16),
+          DrawingPoint(offset: const Offset(30, 22), timestamp: 1e12 + 32),
+        ],
+        color: Colors.black,
+        width: 4.0,
+        tool: DrawingTool.pencil,
+      );
+      final committed = live.copyWith(points: [
+        first,
+        DrawingPoint(offset: const Offset(18, 22), timestamp: 1e12 + 16),
+        DrawingPoint(offset: const Offset(30, 22), timestamp: 1e12 + 32),
+      ]);
+
+      expect(StrokeNoise.seedFor(live), StrokeNoise.seedFor(committed));
+    });
+
+    test('empty stroke should have a zero seed', () {
+      final stroke = Stroke(
+        points: [],
+        color: Colors.black,
+        width: 1.0,
+        tool: DrawingTool.pen,
+      );
+      expect(StrokeNoise.seedFor(stroke), 0);
+    });
+  });
+}
@@ -0,0 +1,140 @@
+import 'package:flutter/material.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/models/stroke.dart';
+import 'package:professional_sketcher/utils/stroke_index.dart';
+import 'package:professional_sketcher/utils/vector_eraser.dart';
+
+Stroke _line(Offset from, Offset to,
+    {DrawingTool tool = DrawingTool.pen, double width = 2.0}) {
+  return Stroke(
+    points: [
+      DrawingPoint(offset: from, pressure: 0.2, timestamp: 0),
+      DrawingPoint(offset: to, pressure: 1.0, timestamp: 100),
+    ],
+    color: Colors.black,
+    width: width,
+    tool: tool,
+  );
+}
+
+void main() {
+  group('VectorEraser Tests', () {
+    const vertical = [Offset(100, 0), Offset(100, 100)];
+
+    test('should cut a crossed segment at the eraser edge', () {
+      final stroke = _line(const Offset(0, 50), const Offset(200, 50));
+
+      final fragments = VectorEraser.split(stroke, vertical, 3.0)!;
+
+      expect(fragments, hasLength(2));
+      expect(fragments[0].points.first.offset, const Offset(0, 50));
+      expect(fragments[0].points.last.offset.dx, closeTo(96, 0.05));
+      expect(fragments[1].points.first.offset.dx, closeTo(104, 0.05));
+      expect(fragments[1].points.last.offset, const Offset(200, 50));
+    });
+
+    test('should interpolate pressure and timestamp at the cut', () {
+      final stroke = _line(const Offset(0, 50), const Offset(200, 50));
+
+      final cut = VectorEraser.split(stroke, vertical, 3.0)![0].points.last;
+
+      expect(cut.pressure, closeTo(0.2 + 0.8 * 0.48, 0.01));
+      expect(cut.timestamp, closeTo(48, 0.5));
+    });
+
+    test('should copy everything but the points to each fragment', () {
+      final stroke = _line(const Offset(0, 50), const Offset(200, 50),
+          tool: DrawingTool.marker, width: 12.0);
+
+      final fragments = VectorEraser.split(stroke, vertical, 3.0)!;
+
+      for (final fragment in fragments) {
+        expect(fragment.tool, DrawingTool.marker);
+        expect(fragment.width, 12.0);
+        expect(fragment.color, stroke.color);
+      }
+    });
+
+    test('should return null for a stroke the eraser misses', () {
+      final stroke = _line(const Offset(0, 50), const Offset(90, 50));
+
+      expect(VectorEraser.split(stroke, vertical, 3.0), isNull);
+    });
+
+    test('should return no fragments for a stroke fully under the eraser',
+        () {
+      final stroke = _line(const Offset(98, 20), const Offset(98, 80));
+
+      expect(VectorEraser.split(stroke, vertical, 3.0), isEmpty);
+    });
+
+    test('should only split pen, pencil and marker strokes', () {
+      expect(VectorEraser.canSplit(_line(Offset.zero, const Offset(1, 1))),
+          isTrue);
+      expect(
+          VectorEraser.canSplit(_line(Offset.zero, const Offset(1, 1),
+              tool: DrawingTool.brush)),
+          isFalse);
+    });
+
+    test('should replace touched strokes in place and keep the rest', () {
+      final above = _line(const Offset(0, 20), const Offset(200, 20));
+      final crossed = _line(const Offset(0, 50), const Offset(200, 50));
+      final below = _line(const Offset(0, 150), const Offset(200, 150));
+      final index = StrokeIndex()..sync([above, crossed, below]);
+      final removed = <Stroke>[];
+
+      final result = VectorEraser.apply(
+        [above, crossed, below],
+        const [Offset(100, 40), Offset(100, 60)],
+        3.0,
+        index,
+        onRemoved: removed.add,
+      )!;
+
+      expect(result, hasLength(4));
+      expect(identical(result.first, above), isTrue);
+      expect(identical(result.last, below), isTrue);
+      expect(removed, [crossed]);
+    });
+  });
+
+  group('StrokeIndex Tests', () {
+    test('should find strokes near a query segment', () {
+      final near = _line(const Offset(0, 50), const Offset(300, 50));
+      final far = _line(const Offset(0, 400), const Offset(300, 400));
+      final index = StrokeIndex()..sync([near, far]);
+
+      final hits = index.strokesTouching(
+          const Offset(150, 40), const Offset(150, 60), 2);
+
+      expect(hits, {near});
+    });
+
+    test('should account for stroke width in hit tests', () {
+      final thick = _line(const Offset(0, 50), const Offset(300, 50),
+          width: 20.0);
+      final index = StrokeIndex()..add(thick);
+
+      const inside = Offset(150, 58);
+      const outside = Offset(150, 70);
+
+      expect(index.strokesTouching(inside, inside, 1), {thick});
+      expect(index.strokesTouching(outside, outside, 1), isEmpty);
+    });
+
+    test('should drop strokes that left the list on sync', () {
+      final a = _line(const Offset(0, 50), const Offset(300, 50));
+      final b = _line(const Offset(0, 60), const Offset(300, 60));
+      final index = StrokeIndex()..sync([a, b]);
+
+      index.sync([b]);
+
+      expect(index.length, 1);
+      expect(index.contains(a), isFalse);
+      expect(index.strokesAlong(const [Offset(10, 40), Offset(10, 70)], 1),
+          {b});
+    });
+  });
+}
@@ -1,9 +1,12 @@
+import 'dart:ui' as ui;
 import 'package:flutter/material.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:get/get.dart';
 import 'package:professional_sketcher/widgets/drawing_canvas.dart';
 import 'package:professional_sketcher/controllers/sketch_controller.dart';
 import 'package:professional_sketcher/models/drawing_tool.dart';
+import 'package:professional_sketcher/painters/sketch_painter.dart';
+import 'package:professional_sketcher/utils/image_tracker.dart';
 
 void main() {
   group('DrawingCanvas Widget Tests', () {
@@ -11,6 +14,7 @@ void main() {
 
     setUp(() {
       Get.testMode = true;
+      ImageTracker.reset();
       controller = SketchController();
       Get.put(controller);
     });
@@ -39,7 +43,13 @@ void main() {
     });
 
     tearDown(() {
+      // Deleting runs onClose, which releases the controller's pictures
+      if (Get.isRegistered<SketchController>()) {
+        Get.delete<SketchController>(force: true);
+      }
       Get.reset();
+      expect(ImageTracker.leaks(), isEmpty,
+          reason: ImageTracker.describeLeaks());
     });
 
     testWidgets('should render DrawingCanvas widget',
@@ -377,6 +387,37 @@ void main() {
       expect(controller.isImageVisible.value, isFalse);
     });
 
+    testWidgets('removing the background image disposes it', (tester) async {
+      final recorder = ui.PictureRecorder();
+      Canvas(recorder).drawRect(
+          const Rect.fromLTWH(0, 0, 8, 8), Paint()..color = Colors.red);
+      final picture = recorder.endRecording();
+      final image = picture.toImageSync(8, 8);
+      picture.dispose();
+
+      await tester.pumpWidget(
+        MaterialApp(
+          home: Scaffold(
+            body: DrawingCanvas(),
+          ),
+        ),
+      );
+      await tester.pumpAndSettle();
+
+      controller.setBackgroundImage(_ReadyImage(image));
+      await tester.pumpAndSettle();
+      expect(ImageTracker.leaks(site: 'DrawingCanvas.backgroundImage'),
+          hasLength(1));
+
+      await tester.tap(find.byKey(const Key('remove-background-button')));
+      await tester.pumpAndSettle();
+
+      expect(controller.backgroundImage.value, isNull);
+      expect(ImageTracker.leaks(site: 'DrawingCanvas.backgroundImage'),
+          isEmpty);
+      image.dispose();
+    });
+
     testWidgets('should handle different screen orientations',
         (WidgetTester tester) async {
       // Test portrait
@@ -530,5 +571,132 @@ void main() {
       // Should handle extreme values without crashing
       expect(find.byType(DrawingCanvas), findsOneWidget);
     });
+
+    testWidgets('lasso selects and drags strokes on the canvas',
+        (tester) async {
+      await tester.pumpWidget(
+        MaterialApp(
+          home: Scaffold(
+            body: DrawingCanvas(),
+          ),
+        ),
+      );
+      await tester.pumpAndSettle();
+
+      controller.setTool(DrawingTool.pen);
+      controller.startStroke(const Offset(100, 100), 1.0);
+      controller.addPoint(const Offset(150, 100), 1.0);
+      controller.addPoint(const Offset(200, 100), 1.0);
+      controller.endStroke();
+
+      await tester.tap(find.byKey(const Key('lasso-button')));
+      await tester.pump();
+      expect(controller.lassoMode.value, isTrue);
+
+      final origin =
+          tester.getTopLeft(find.byKey(const Key('drawing-area')));
+      final lasso = await tester.startGesture(origin + const Offset(80, 80));
+      for (final corner in const [
+        Offset(220, 80),
+        Offset(220, 120),
+        Offset(80, 120),
+      ]) {
+        await lasso.moveTo(origin + corner);
+        await tester.pump();
+      }
+      await lasso.up();
+      await tester.pump();
+      expect(controller.selection, hasLength(1));
+
+      final drag = await tester.startGesture(origin + const Offset(150, 100));
+      await drag.moveTo(origin + const Offset(175, 115));
+      await tester.pump();
+      await drag.moveTo(origin + const Offset(200, 130));
+      await tester.pump();
+      expect(controller.isTransformingSelection, isTrue);
+      expect(ImageTracker.livePictures, 1);
+      await drag.up();
+      await tester.pump();
+
+      expect(controller.isTransformingSelection, isFalse);
+      expect(controller.strokes.single.points.first.offset,
+          const Offset(150, 130));
+      expect(ImageTracker.livePictures, 0);
+    });
+
+    testWidgets('layers panel adds and switches layers', (tester) async {
+      await tester.pumpWidget(
+        MaterialApp(
+          home: Scaffold(
+            body: DrawingCanvas(),
+          ),
+        ),
+      );
+      await tester.pumpAndSettle();
+
+      controller.startStroke(const Offset(100, 100), 1.0);
+      controller.addPoint(const Offset(200, 100), 1.0);
+      controller.endStroke();
+
+      await tester.tap(find.byKey(const Key('layers-button')));
+      await tester.pumpAndSettle();
+      await tester.tap(find.byKey(const Key('add-layer-button')));
+      await tester.pumpAndSettle();
+
+      expect(controller.layers, hasLength(2));
+      expect(controller.activeLayerIndex.value, 1);
+      expect(controller.strokes, isEmpty);
+      // The bottom layer is now drawn from one recorded picture
+      expect(SketchPainter.cachedLayerCount, 1);
+      expect(ImageTracker.livePictures, 1);
+
+      await tester.tap(find.byKey(const Key('layer-tile-0')));
+      await tester.pumpAndSettle();
+      expect(controller.activeLayerIndex.value, 0);
+      expect(controller.strokes, hasLength(1));
+    });
+
+    testWidgets('perf overlay toggles from the toolbar', (tester) async {
+      await tester.pumpWidget(
+        MaterialApp(
+          home: Scaffold(
+            body: DrawingCanvas(),
+          ),
+        ),
+      );
+      await tester.pumpAndSettle();
+
+      expect(find.byKey(const Key('perf-overlay')), findsNothing);
+      SketchPainter.stats.boundsCacheMisses = 1 << 20;
+
+      await tester.tap(find.byKey(const Key('perf-overlay-button')));
+      await tester.pump();
+      expect(controller.showPerfOverlay.value, isTrue);
+      // Hit rates start over when the overlay is shown
+      expect(SketchPainter.stats.boundsCacheMisses, lessThan(1 << 20));
+      expect(find.byKey(const Key('perf-overlay')), findsOneWidget);
+      expect(find.textContaining('raster p50'), findsOneWidget);
+
+      await tester.tap(find.byKey(const Key('perf-overlay-button')));
+      await tester.pump();
+      expect(find.byKey(const Key('perf-overlay')), findsNothing);
+    });
   });
 }
+
+/// Resolves synchronously to [image], so no decoding is involved.
+class _ReadyImage extends ImageProvider<_ReadyImage> {
+  final ui.Image image;
+
+  const _ReadyImage(this.image);
+
+  @override
+  Future<_ReadyImage> obtainKey(ImageConfiguration configuration) =>
+      SynchronousFuture<_ReadyImage>(this);
+
+  @override
+  ImageStreamCompleter loadImage(
+          _ReadyImage key, ImageDecoderCallback decode) =>
+      OneFrameImageStreamCompleter(
+          SynchronousFuture<ImageInfo>(ImageInfo(image: image)));
+}